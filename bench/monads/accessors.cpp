@@ -0,0 +1,57 @@
+#include <monads/either.hpp>
+#include <monads/result.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+using namespace monad;
+
+namespace
+{
+   auto make_payload() -> std::string { return std::string(256, 'x'); }
+} // namespace
+
+static void result_value_copy(benchmark::State& state)
+{
+   const result<std::string, int> r{make_value(make_payload())};
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      benchmark::DoNotOptimize(r.value().value().size());
+   }
+}
+BENCHMARK(result_value_copy);
+
+static void result_value_ptr(benchmark::State& state)
+{
+   const result<std::string, int> r{make_value(make_payload())};
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      benchmark::DoNotOptimize(r.value_ptr()->size());
+   }
+}
+BENCHMARK(result_value_ptr);
+
+static void either_right_copy(benchmark::State& state)
+{
+   const either<int, std::string> e{make_right(make_payload())};
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      benchmark::DoNotOptimize(e.right().value().size());
+   }
+}
+BENCHMARK(either_right_copy);
+
+static void either_right_ptr(benchmark::State& state)
+{
+   const either<int, std::string> e{make_right(make_payload())};
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      benchmark::DoNotOptimize(e.right_ptr()->size());
+   }
+}
+BENCHMARK(either_right_ptr);
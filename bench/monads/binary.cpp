@@ -0,0 +1,196 @@
+#include <monads/binary.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace monad;
+
+namespace
+{
+   using outcome = result<std::int64_t, std::errc>;
+
+   /**
+    * The conversion the binary layout replaces: every outcome is turned into a plain record
+    * before being written, and turned back into an outcome when read
+    */
+   struct naive_record
+   {
+      std::uint8_t is_error;
+      std::int64_t payload;
+   };
+
+   auto naive_write(const std::string& path, const std::vector<outcome>& outcomes) -> bool
+   {
+      std::FILE* file = std::fopen(path.c_str(), "wb");
+      if (file == nullptr)
+      {
+         return false;
+      }
+
+      const std::uint64_t count = outcomes.size();
+      bool written = std::fwrite(&count, sizeof(count), 1, file) == 1;
+
+      for (const auto& o : outcomes)
+      {
+         const naive_record record{
+            static_cast<std::uint8_t>(!o.is_value()),
+            o.is_value() ? *o.value_ptr() : static_cast<std::int64_t>(*o.error_ptr())};
+
+         written = written && std::fwrite(&record, sizeof(record), 1, file) == 1;
+      }
+
+      return std::fclose(file) == 0 && written;
+   }
+
+   auto naive_read(const std::string& path) -> std::vector<outcome>
+   {
+      std::vector<outcome> outcomes;
+
+      std::FILE* file = std::fopen(path.c_str(), "rb");
+      if (file == nullptr)
+      {
+         return outcomes;
+      }
+
+      std::uint64_t count = 0;
+      if (std::fread(&count, sizeof(count), 1, file) == 1)
+      {
+         outcomes.reserve(count);
+
+         naive_record record{};
+         while (std::fread(&record, sizeof(record), 1, file) == 1)
+         {
+            if (record.is_error != 0)
+            {
+               outcomes.emplace_back(make_error(static_cast<std::errc>(record.payload)));
+            }
+            else
+            {
+               outcomes.emplace_back(make_value(record.payload));
+            }
+         }
+      }
+
+      std::fclose(file);
+
+      return outcomes;
+   }
+
+   auto make_outcomes(std::int64_t count) -> std::vector<outcome>
+   {
+      std::vector<outcome> outcomes;
+      outcomes.reserve(static_cast<std::size_t>(count));
+
+      for (std::int64_t i = 0; i < count; ++i)
+      {
+         if (i % 13 == 0)
+         {
+            outcomes.emplace_back(make_error(std::errc::timed_out));
+         }
+         else
+         {
+            outcomes.emplace_back(make_value(i * 7));
+         }
+      }
+
+      return outcomes;
+   }
+
+   auto sum(const auto& outcomes) -> std::int64_t
+   {
+      std::int64_t total = 0;
+
+      for (const auto& o : outcomes)
+      {
+         total += o.is_value() ? *o.value_ptr() : -1;
+      }
+
+      return total;
+   }
+
+   auto bench_path(const char* name) -> std::string
+   {
+      return (std::filesystem::temp_directory_path() / name).string();
+   }
+} // namespace
+
+static void binary_write(benchmark::State& state)
+{
+   const auto outcomes = make_outcomes(state.range(0));
+   const auto path = bench_path("monads_bench_binary.bin");
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      auto written = write_binary(path.c_str(), outcomes);
+      benchmark::DoNotOptimize(written);
+   }
+
+   state.SetBytesProcessed(state.iterations() * state.range(0) *
+                           static_cast<std::int64_t>(sizeof(outcome)));
+   std::filesystem::remove(path);
+}
+BENCHMARK(binary_write)->Arg(1 << 16)->Arg(1 << 20);
+
+static void naive_write(benchmark::State& state)
+{
+   const auto outcomes = make_outcomes(state.range(0));
+   const auto path = bench_path("monads_bench_naive.bin");
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      auto written = naive_write(path, outcomes);
+      benchmark::DoNotOptimize(written);
+   }
+
+   state.SetBytesProcessed(state.iterations() * state.range(0) *
+                           static_cast<std::int64_t>(sizeof(outcome)));
+   std::filesystem::remove(path);
+}
+BENCHMARK(naive_write)->Arg(1 << 16)->Arg(1 << 20);
+
+/**
+ * Map the file and read every outcome in place
+ */
+static void binary_map_and_sum(benchmark::State& state)
+{
+   const auto path = bench_path("monads_bench_binary.bin");
+   static_cast<void>(write_binary(path.c_str(), make_outcomes(state.range(0))));
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      const auto mapped = mapped_array<outcome>::open(path.c_str());
+      auto total = sum(mapped.value_ptr()->elements());
+      benchmark::DoNotOptimize(total);
+   }
+
+   state.SetBytesProcessed(state.iterations() * state.range(0) *
+                           static_cast<std::int64_t>(sizeof(outcome)));
+   std::filesystem::remove(path);
+}
+BENCHMARK(binary_map_and_sum)->Arg(1 << 16)->Arg(1 << 20);
+
+/**
+ * Read the file record by record and rebuild the outcomes before reading them
+ */
+static void naive_read_and_sum(benchmark::State& state)
+{
+   const auto path = bench_path("monads_bench_naive.bin");
+   static_cast<void>(naive_write(path, make_outcomes(state.range(0))));
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      auto total = sum(naive_read(path));
+      benchmark::DoNotOptimize(total);
+   }
+
+   state.SetBytesProcessed(state.iterations() * state.range(0) *
+                           static_cast<std::int64_t>(sizeof(outcome)));
+   std::filesystem::remove(path);
+}
+BENCHMARK(naive_read_and_sum)->Arg(1 << 16)->Arg(1 << 20);
@@ -0,0 +1,96 @@
+#include <monads/boxed.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace monad;
+
+namespace
+{
+   struct rich_error
+   {
+      int code{0};
+      std::array<char, 192> context{};
+   };
+
+   template <class error_>
+   [[gnu::noinline]] auto parse(std::int64_t i) -> result<std::int64_t, error_>
+   {
+      if (i < 0) [[unlikely]]
+      {
+         return make_error(error_{rich_error{.code = static_cast<int>(i)}});
+      }
+
+      return make_value(i * 2);
+   }
+} // namespace
+
+static void result_inline_error_success(benchmark::State& state)
+{
+   for ([[maybe_unused]] auto _ : state)
+   {
+      std::int64_t sum = 0;
+      for (std::int64_t i = 0; i < state.range(0); ++i)
+      {
+         sum += *parse<rich_error>(i).value_ptr();
+      }
+
+      benchmark::DoNotOptimize(sum);
+   }
+}
+BENCHMARK(result_inline_error_success)->Arg(1024);
+
+static void result_boxed_error_success(benchmark::State& state)
+{
+   for ([[maybe_unused]] auto _ : state)
+   {
+      std::int64_t sum = 0;
+      for (std::int64_t i = 0; i < state.range(0); ++i)
+      {
+         sum += *parse<boxed<rich_error>>(i).value_ptr();
+      }
+
+      benchmark::DoNotOptimize(sum);
+   }
+}
+BENCHMARK(result_boxed_error_success)->Arg(1024);
+
+static void error_burst_pooled_box(benchmark::State& state)
+{
+   std::vector<boxed<rich_error>> errors;
+   errors.reserve(static_cast<std::size_t>(state.range(0)));
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      for (std::int64_t i = 0; i < state.range(0); ++i)
+      {
+         errors.emplace_back(rich_error{.code = static_cast<int>(i)});
+      }
+
+      benchmark::DoNotOptimize(errors.data());
+      errors.clear();
+   }
+}
+BENCHMARK(error_burst_pooled_box)->Arg(1024);
+
+static void error_burst_unique_ptr(benchmark::State& state)
+{
+   std::vector<std::unique_ptr<rich_error>> errors;
+   errors.reserve(static_cast<std::size_t>(state.range(0)));
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      for (std::int64_t i = 0; i < state.range(0); ++i)
+      {
+         errors.push_back(std::make_unique<rich_error>(rich_error{.code = static_cast<int>(i)}));
+      }
+
+      benchmark::DoNotOptimize(errors.data());
+      errors.clear();
+   }
+}
+BENCHMARK(error_burst_unique_ptr)->Arg(1024);
@@ -0,0 +1,132 @@
+#include <monads/coroutine.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+using namespace monad;
+
+namespace
+{
+   enum struct parse_error
+   {
+      out_of_range,
+      odd
+   };
+
+   [[gnu::noinline]] auto bounded(std::int64_t i) -> result<std::int64_t, parse_error>
+   {
+      if (i < 0 || i > 1'000'000)
+      {
+         return make_error(parse_error::out_of_range);
+      }
+
+      return make_value(i + 1);
+   }
+
+   [[gnu::noinline]] auto even(std::int64_t i) -> result<std::int64_t, parse_error>
+   {
+      if (i % 2 != 0)
+      {
+         return make_error(parse_error::odd);
+      }
+
+      return make_value(i / 2);
+   }
+
+   auto with_and_then(std::int64_t i) -> result<std::int64_t, parse_error>
+   {
+      return bounded(i).and_then([](std::int64_t a) {
+         return even(a).and_then([a](std::int64_t b) {
+            return bounded(b).and_then([a, b](std::int64_t c) {
+               return even(c + 1).map([a, b, c](std::int64_t d) { return a + b + c + d; });
+            });
+         });
+      });
+   }
+
+   auto with_early_returns(std::int64_t i) -> result<std::int64_t, parse_error>
+   {
+      const auto a = bounded(i);
+      if (!a.is_value())
+      {
+         return make_error(*a.error_ptr());
+      }
+
+      const auto b = even(*a.value_ptr());
+      if (!b.is_value())
+      {
+         return make_error(*b.error_ptr());
+      }
+
+      const auto c = bounded(*b.value_ptr());
+      if (!c.is_value())
+      {
+         return make_error(*c.error_ptr());
+      }
+
+      const auto d = even(*c.value_ptr() + 1);
+      if (!d.is_value())
+      {
+         return make_error(*d.error_ptr());
+      }
+
+      return make_value(*a.value_ptr() + *b.value_ptr() + *c.value_ptr() + *d.value_ptr());
+   }
+
+   auto with_co_await(std::int64_t i) -> result<std::int64_t, parse_error>
+   {
+      const std::int64_t a = co_await bounded(i);
+      const std::int64_t b = co_await even(a);
+      const std::int64_t c = co_await bounded(b);
+      const std::int64_t d = co_await even(c + 1);
+
+      co_return a + b + c + d;
+   }
+
+   /**
+    * An input of 3 succeeds all the way through, an input of 2 fails at the second step
+    */
+   template <auto parse_>
+   void run(benchmark::State& state)
+   {
+      std::int64_t i = state.range(0);
+
+      for ([[maybe_unused]] auto _ : state)
+      {
+         benchmark::DoNotOptimize(i);
+         auto r = parse_(i);
+         benchmark::DoNotOptimize(r);
+      }
+   }
+} // namespace
+
+static void and_then_chain(benchmark::State& state)
+{
+   run<with_and_then>(state);
+}
+BENCHMARK(and_then_chain)->Arg(3)->Arg(2);
+
+static void early_returns(benchmark::State& state)
+{
+   run<with_early_returns>(state);
+}
+BENCHMARK(early_returns)->Arg(3)->Arg(2);
+
+static void co_await_heap_frame(benchmark::State& state)
+{
+   run<with_co_await>(state);
+}
+BENCHMARK(co_await_heap_frame)->Arg(3)->Arg(2);
+
+static void co_await_arena_frame(benchmark::State& state)
+{
+   std::array<std::byte, 4096> buffer{};
+   coroutine_arena arena{buffer};
+   const coroutine_arena::scope scope{arena};
+
+   run<with_co_await>(state);
+}
+BENCHMARK(co_await_arena_frame)->Arg(3)->Arg(2);
@@ -0,0 +1,95 @@
+#include <monads/error.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+using namespace monad;
+
+// A lookup that fails on one input in four, reporting the failure either as a formatted string,
+// as the services do today, or as an interned monad::error whose message is never rendered
+// because the caller only checks is_value().
+
+enum class lookup_code : std::uint16_t
+{
+   out_of_range
+};
+
+template <>
+struct monad::error_category<lookup_code>
+{
+   static constexpr std::uint16_t id = 1;
+   static constexpr std::string_view name = "lookup";
+   static constexpr std::array<std::string_view, 1> messages{"index {} out of range, limit {}"};
+};
+
+namespace
+{
+   constexpr std::int64_t limit = 768;
+
+   [[gnu::noinline]] auto string_lookup(std::int64_t index) -> result<std::int64_t, std::string>
+   {
+      if (index >= limit)
+      {
+         return make_error("index " + std::to_string(index) + " out of range, limit " +
+                           std::to_string(limit));
+      }
+
+      return make_value(index * 3);
+   }
+
+   [[gnu::noinline]] auto error_lookup(std::int64_t index) -> result<std::int64_t, error>
+   {
+      if (index >= limit)
+      {
+         return make_error(error{lookup_code::out_of_range, index, limit});
+      }
+
+      return make_value(index * 3);
+   }
+} // namespace
+
+static void string_error_check(benchmark::State& state)
+{
+   std::int64_t index = 0;
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      auto r = string_lookup(index++ & 1023).map([](std::int64_t i) { return i + 1; });
+      benchmark::DoNotOptimize(r.is_value());
+   }
+}
+BENCHMARK(string_error_check);
+
+static void interned_error_check(benchmark::State& state)
+{
+   std::int64_t index = 0;
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      auto r = error_lookup(index++ & 1023).map([](std::int64_t i) { return i + 1; });
+      benchmark::DoNotOptimize(r.is_value());
+   }
+}
+BENCHMARK(interned_error_check);
+
+/**
+ * Rendering the message of every failure, the cost moved out of the failure path
+ */
+static void interned_error_message(benchmark::State& state)
+{
+   std::int64_t index = 0;
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      auto r = error_lookup(index++ & 1023);
+      if (!r.is_value())
+      {
+         auto message = r.error_ptr()->message();
+         benchmark::DoNotOptimize(message);
+      }
+   }
+}
+BENCHMARK(interned_error_message);
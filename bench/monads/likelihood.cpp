@@ -0,0 +1,132 @@
+#include <monads/maybe.hpp>
+#include <monads/result.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace monad;
+
+// The chains below are kept out of line so that their code can be inspected with
+//
+//    objdump -d --no-show-raw-insn -C monads_bench | awk '/<.*result_chain/,/^$/'
+//
+// With the default policy the value path runs from the entry to the first ret without a taken
+// branch, and the copies of the error live in the [clone .cold] part of the function. Build with
+// -DMONADS_FAILURE_IS_LIKELY to compare against the inverted layout.
+
+namespace
+{
+   struct parse_error
+   {
+      std::string message;
+      std::int64_t position;
+   };
+
+   [[gnu::noinline]] auto checked_step(std::int64_t i) -> result<std::int64_t, parse_error>
+   {
+      if (i % 1000 < 0)
+      {
+         return make_error(parse_error{"negative input in the middle of the stream", i});
+      }
+
+      return make_value(i + 7);
+   }
+
+   [[gnu::noinline]] auto result_chain(const result<std::int64_t, parse_error>& input)
+      -> result<std::int64_t, parse_error>
+   {
+      return input.map([](std::int64_t i) { return i * 3; })
+         .and_then(checked_step)
+         .map([](std::int64_t i) { return i ^ 0x5A5A; });
+   }
+
+   [[gnu::noinline]] auto maybe_chain(const maybe<std::int64_t>& input) -> maybe<std::int64_t>
+   {
+      return input.map([](std::int64_t i) { return i * 3; })
+         .and_then([](std::int64_t i) -> maybe<std::int64_t> {
+            if (i < 0)
+            {
+               return none;
+            }
+
+            return i + 7;
+         })
+         .map([](std::int64_t i) { return i ^ 0x5A5A; });
+   }
+
+   /**
+    * 1024 inputs of which one in every `failure_every` is an error, or none if it is 0
+    */
+   auto make_inputs(std::int64_t failure_every) -> std::vector<result<std::int64_t, parse_error>>
+   {
+      std::vector<result<std::int64_t, parse_error>> inputs;
+      inputs.reserve(1024);
+
+      for (std::int64_t i = 0; i < 1024; ++i)
+      {
+         if (failure_every != 0 && i % failure_every == 0)
+         {
+            inputs.emplace_back(make_error(parse_error{"invalid token", i}));
+         }
+         else
+         {
+            inputs.emplace_back(make_value(i));
+         }
+      }
+
+      return inputs;
+   }
+} // namespace
+
+static void result_chain_failure_rate(benchmark::State& state)
+{
+   const auto inputs = make_inputs(state.range(0));
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      std::int64_t sum = 0;
+
+      for (const auto& input : inputs)
+      {
+         auto out = result_chain(input);
+         sum += out.is_value() ? *out.value_ptr() : out.error_ptr()->position;
+      }
+
+      benchmark::DoNotOptimize(sum);
+   }
+}
+BENCHMARK(result_chain_failure_rate)->Arg(0)->Arg(100)->Arg(2)->Arg(1);
+
+static void maybe_chain_failure_rate(benchmark::State& state)
+{
+   std::vector<maybe<std::int64_t>> inputs;
+   inputs.reserve(1024);
+
+   for (std::int64_t i = 0; i < 1024; ++i)
+   {
+      if (state.range(0) != 0 && i % state.range(0) == 0)
+      {
+         inputs.emplace_back();
+      }
+      else
+      {
+         inputs.emplace_back(i);
+      }
+   }
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      std::int64_t sum = 0;
+
+      for (const auto& input : inputs)
+      {
+         sum += maybe_chain(input).value_or(-1);
+      }
+
+      benchmark::DoNotOptimize(sum);
+   }
+}
+BENCHMARK(maybe_chain_failure_rate)->Arg(0)->Arg(100)->Arg(2)->Arg(1);
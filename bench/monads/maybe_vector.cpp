@@ -0,0 +1,102 @@
+#include <monads/maybe_vector.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace monad;
+
+namespace
+{
+   constexpr auto is_engaged(std::int64_t i) -> bool { return i % 7 != 0; }
+} // namespace
+
+static void vector_of_maybe_value_or(benchmark::State& state)
+{
+   std::vector<maybe<std::int32_t>> column;
+
+   for (std::int64_t i = 0; i < state.range(0); ++i)
+   {
+      column.push_back(is_engaged(i) ? maybe<std::int32_t>{static_cast<std::int32_t>(i)}
+                                     : maybe<std::int32_t>{});
+   }
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      std::int64_t sum = 0;
+
+      for (const auto& m : column)
+      {
+         sum += m.value_or(0);
+      }
+
+      benchmark::DoNotOptimize(sum);
+   }
+}
+BENCHMARK(vector_of_maybe_value_or)->Range(1 << 10, 1 << 22);
+
+static void maybe_vector_value_or(benchmark::State& state)
+{
+   maybe_vector<std::int32_t> column;
+
+   for (std::int64_t i = 0; i < state.range(0); ++i)
+   {
+      column.push_back(is_engaged(i) ? maybe<std::int32_t>{static_cast<std::int32_t>(i)}
+                                     : maybe<std::int32_t>{});
+   }
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      std::int64_t sum = 0;
+
+      for (const auto value : column.value_or(0))
+      {
+         sum += value;
+      }
+
+      benchmark::DoNotOptimize(sum);
+   }
+}
+BENCHMARK(maybe_vector_value_or)->Range(1 << 10, 1 << 22);
+
+static void vector_of_maybe_count(benchmark::State& state)
+{
+   std::vector<maybe<std::int32_t>> column;
+
+   for (std::int64_t i = 0; i < state.range(0); ++i)
+   {
+      column.push_back(is_engaged(i) ? maybe<std::int32_t>{static_cast<std::int32_t>(i)}
+                                     : maybe<std::int32_t>{});
+   }
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      std::int64_t count = 0;
+
+      for (const auto& m : column)
+      {
+         count += m.has_value();
+      }
+
+      benchmark::DoNotOptimize(count);
+   }
+}
+BENCHMARK(vector_of_maybe_count)->Range(1 << 10, 1 << 22);
+
+static void maybe_vector_count(benchmark::State& state)
+{
+   maybe_vector<std::int32_t> column;
+
+   for (std::int64_t i = 0; i < state.range(0); ++i)
+   {
+      column.push_back(is_engaged(i) ? maybe<std::int32_t>{static_cast<std::int32_t>(i)}
+                                     : maybe<std::int32_t>{});
+   }
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      benchmark::DoNotOptimize(column.count_engaged());
+   }
+}
+BENCHMARK(maybe_vector_count)->Range(1 << 10, 1 << 22);
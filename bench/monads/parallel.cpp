@@ -0,0 +1,113 @@
+#include <monads/parallel.hpp>
+#include <monads/traverse.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace monad;
+
+namespace
+{
+   constexpr std::size_t record_count = 1'000'000;
+
+   struct record
+   {
+      std::uint64_t key{0};
+      std::uint64_t payload{0};
+   };
+
+   /**
+    * A CPU bound validator: a few rounds of mixing over the record, failing on a marked key
+    */
+   auto validate(const record& r) -> result<std::uint64_t, std::uint64_t>
+   {
+      if (r.key == ~std::uint64_t{0})
+      {
+         return make_error(r.payload);
+      }
+
+      std::uint64_t h = r.key ^ r.payload;
+      for (int round = 0; round < 64; ++round)
+      {
+         h ^= h >> 33U;
+         h *= 0xff51afd7ed558ccdULL;
+      }
+
+      return make_value(h);
+   }
+
+   auto make_records(std::size_t failure_at) -> std::vector<record>
+   {
+      std::vector<record> records(record_count);
+
+      for (std::size_t i = 0; i < records.size(); ++i)
+      {
+         records[i] = record{.key = i == failure_at ? ~std::uint64_t{0} : i, .payload = i * 7};
+      }
+
+      return records;
+   }
+
+   void worker_counts(benchmark::internal::Benchmark* b)
+   {
+      const auto hardware = static_cast<std::int64_t>(std::thread::hardware_concurrency());
+
+      for (std::int64_t workers = 1; workers < hardware; workers *= 2)
+      {
+         b->Arg(workers);
+      }
+
+      b->Arg(std::max<std::int64_t>(hardware, 1));
+   }
+} // namespace
+
+static void sequential_traverse(benchmark::State& state)
+{
+   const auto records = make_records(record_count);
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      auto r = traverse(records, validate);
+      benchmark::DoNotOptimize(r);
+   }
+
+   state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(record_count));
+}
+BENCHMARK(sequential_traverse)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void parallel_traverse(benchmark::State& state)
+{
+   const auto records = make_records(record_count);
+   const par_policy policy{.workers = static_cast<std::size_t>(state.range(0))};
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      auto r = par_traverse(policy, records, validate);
+      benchmark::DoNotOptimize(r);
+   }
+
+   state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(record_count));
+}
+BENCHMARK(parallel_traverse)->Apply(worker_counts)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+/**
+ * The failing record sits at a tenth of the input, the workers must stop soon after reaching it
+ */
+static void parallel_traverse_early_failure(benchmark::State& state)
+{
+   const auto records = make_records(record_count / 10);
+   const par_policy policy{.workers = static_cast<std::size_t>(state.range(0))};
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      auto r = par_traverse(policy, records, validate);
+      benchmark::DoNotOptimize(r);
+   }
+}
+BENCHMARK(parallel_traverse_early_failure)
+   ->Apply(worker_counts)
+   ->Unit(benchmark::kMillisecond)
+   ->UseRealTime();
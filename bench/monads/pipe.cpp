@@ -0,0 +1,123 @@
+#include <monads/pipe.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+
+using namespace monad;
+
+namespace
+{
+   struct packet
+   {
+      std::array<std::uint8_t, 512> bytes{};
+      std::uint32_t checksum{0};
+   };
+
+   auto make_packet(std::int64_t seed) -> packet
+   {
+      packet p{};
+      p.bytes.fill(static_cast<std::uint8_t>(seed));
+
+      return p;
+   }
+
+   auto stamp(packet p) -> packet
+   {
+      p.checksum = p.checksum * 31U + p.bytes[p.checksum % p.bytes.size()];
+
+      return p;
+   }
+
+   auto validate(packet p) -> maybe<packet>
+   {
+      return p.checksum != 1U ? maybe<packet>{stamp(std::move(p))} : maybe<packet>{};
+   }
+
+   auto validate_result(packet p) -> result<packet, int>
+   {
+      if (p.checksum == 1U)
+      {
+         return make_error(1);
+      }
+
+      return make_value(stamp(std::move(p)));
+   }
+} // namespace
+
+static void maybe_eager_chain(benchmark::State& state)
+{
+   maybe<packet> source{make_packet(state.range(0))};
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      benchmark::DoNotOptimize(source);
+
+      const auto checksum = source.map(stamp)
+                               .map(stamp)
+                               .and_then(validate)
+                               .map(stamp)
+                               .and_then(validate)
+                               .map(stamp)
+                               .map(stamp)
+                               .map([](const packet& p) { return p.checksum; })
+                               .value_or(0U);
+
+      benchmark::DoNotOptimize(checksum);
+   }
+}
+BENCHMARK(maybe_eager_chain)->Arg(3);
+
+static void maybe_fused_pipeline(benchmark::State& state)
+{
+   maybe<packet> source{make_packet(state.range(0))};
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      benchmark::DoNotOptimize(source);
+
+      const auto checksum = pipe(source) | map(stamp) | map(stamp) | and_then(validate) |
+         map(stamp) | and_then(validate) | map(stamp) | map(stamp) |
+         map([](const packet& p) { return p.checksum; }) | value_or(0U);
+
+      benchmark::DoNotOptimize(checksum);
+   }
+}
+BENCHMARK(maybe_fused_pipeline)->Arg(3);
+
+static void result_eager_chain(benchmark::State& state)
+{
+   result<packet, int> source{make_value(make_packet(state.range(0)))};
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      benchmark::DoNotOptimize(source);
+
+      const auto r = source.map(stamp)
+                        .and_then(validate_result)
+                        .map(stamp)
+                        .and_then(validate_result)
+                        .map(stamp)
+                        .map(stamp);
+
+      benchmark::DoNotOptimize(r);
+   }
+}
+BENCHMARK(result_eager_chain)->Arg(3);
+
+static void result_fused_pipeline(benchmark::State& state)
+{
+   result<packet, int> source{make_value(make_packet(state.range(0)))};
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      benchmark::DoNotOptimize(source);
+
+      const result<packet, int> r = pipe(source) | map(stamp) | and_then(validate_result) |
+         map(stamp) | and_then(validate_result) | map(stamp) | map(stamp);
+
+      benchmark::DoNotOptimize(r);
+   }
+}
+BENCHMARK(result_fused_pipeline)->Arg(3);
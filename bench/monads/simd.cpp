@@ -0,0 +1,133 @@
+#include <monads/simd.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace monad;
+
+namespace
+{
+   auto make_column(std::int64_t size) -> std::vector<maybe<std::int32_t>>
+   {
+      std::vector<maybe<std::int32_t>> column;
+      column.reserve(static_cast<std::size_t>(size));
+
+      for (std::int64_t i = 0; i < size; ++i)
+      {
+         column.push_back(i % 7 == 0 ? maybe<std::int32_t>{}
+                                     : maybe<std::int32_t>{static_cast<std::int32_t>(i)});
+      }
+
+      return column;
+   }
+
+   auto make_double_column(std::int64_t size) -> std::vector<maybe<double>>
+   {
+      std::vector<maybe<double>> column;
+      column.reserve(static_cast<std::size_t>(size));
+
+      for (std::int64_t i = 0; i < size; ++i)
+      {
+         column.push_back(i % 7 == 0 ? maybe<double>{} : maybe<double>{static_cast<double>(i)});
+      }
+
+      return column;
+   }
+
+   void apply_isa_args(benchmark::internal::Benchmark* bench)
+   {
+      for (const auto target : {simd::isa::scalar, simd::isa::sse2, simd::isa::avx2,
+                                simd::isa::avx512})
+      {
+         if (target <= simd::active_isa())
+         {
+            bench->Args({1 << 16, static_cast<std::int64_t>(target)});
+         }
+      }
+   }
+} // namespace
+
+static void scalar_value_or_loop(benchmark::State& state)
+{
+   const auto column = make_column(state.range(0));
+   std::vector<std::int32_t> out(column.size());
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      for (std::size_t i = 0; i < column.size(); ++i)
+      {
+         out[i] = column[i].value_or(0);
+      }
+
+      benchmark::DoNotOptimize(out.data());
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(scalar_value_or_loop)->Arg(1 << 16);
+
+static void simd_value_or(benchmark::State& state)
+{
+   const auto column = make_column(state.range(0));
+   const auto target = static_cast<simd::isa>(state.range(1));
+   std::vector<std::int32_t> out(column.size());
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      simd::value_or(column, 0, out, target);
+
+      benchmark::DoNotOptimize(out.data());
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(simd_value_or)->Apply(apply_isa_args);
+
+static void simd_value_or_niche(benchmark::State& state)
+{
+   const auto column = make_double_column(state.range(0));
+   const auto target = static_cast<simd::isa>(state.range(1));
+   std::vector<double> out(column.size());
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      simd::value_or(column, 0.0, out, target);
+
+      benchmark::DoNotOptimize(out.data());
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(simd_value_or_niche)->Apply(apply_isa_args);
+
+static void simd_count_engaged(benchmark::State& state)
+{
+   const auto column = make_column(state.range(0));
+   const auto target = static_cast<simd::isa>(state.range(1));
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      benchmark::DoNotOptimize(simd::count_engaged(column, target));
+   }
+}
+BENCHMARK(simd_count_engaged)->Apply(apply_isa_args);
+
+static void simd_map(benchmark::State& state)
+{
+   const auto column = make_column(state.range(0));
+   const auto target = static_cast<simd::isa>(state.range(1));
+   std::vector<maybe<std::int32_t>> out(column.size());
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      simd::map(
+         column,
+         [](std::int32_t i) noexcept {
+            return i * 3 + 1;
+         },
+         out, target);
+
+      benchmark::DoNotOptimize(out.data());
+      benchmark::ClobberMemory();
+   }
+}
+BENCHMARK(simd_map)->Apply(apply_isa_args);
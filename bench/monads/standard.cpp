@@ -0,0 +1,353 @@
+#include <monads/either.hpp>
+#include <monads/maybe.hpp>
+#include <monads/result.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <system_error>
+#include <variant>
+#include <version>
+
+#if defined(__cpp_lib_expected)
+#  include <expected>
+#endif
+
+using namespace monad;
+
+// maybe, result and either against the standard vocabulary types and plain std::errc returns.
+// Every carrier holds an std::int64_t and, when it has one, an std::errc error. Each operation is
+// written once against an adapter per carrier: chains of and_then and map of a given depth,
+// value_or, construction, copies and moves, and errors propagated through a whole chain.
+
+namespace
+{
+   constexpr std::int64_t failure_marker = -1;
+
+   constexpr auto next(std::int64_t i) noexcept -> std::int64_t { return i * 3 + 1; }
+
+   struct maybe_ops
+   {
+      using type = maybe<std::int64_t>;
+
+      static auto success(std::int64_t i) noexcept -> type { return i; }
+      static auto failure() noexcept -> type { return none; }
+      static auto step(std::int64_t i) noexcept -> type
+      {
+         return i == failure_marker ? failure() : success(next(i));
+      }
+      static auto and_then(type&& m) noexcept -> type { return std::move(m).and_then(step); }
+      static auto map(type&& m) noexcept -> type { return std::move(m).map(next); }
+      static auto value_or(const type& m) noexcept -> std::int64_t { return m.value_or(0); }
+   };
+
+   struct optional_ops
+   {
+      using type = std::optional<std::int64_t>;
+
+      static auto success(std::int64_t i) noexcept -> type { return i; }
+      static auto failure() noexcept -> type { return std::nullopt; }
+      static auto step(std::int64_t i) noexcept -> type
+      {
+         return i == failure_marker ? failure() : success(next(i));
+      }
+      static auto and_then(type&& m) noexcept -> type
+      {
+         return m.has_value() ? step(*m) : std::nullopt;
+      }
+      static auto map(type&& m) noexcept -> type
+      {
+         return m.has_value() ? type{next(*m)} : std::nullopt;
+      }
+      static auto value_or(const type& m) noexcept -> std::int64_t { return m.value_or(0); }
+   };
+
+   struct result_ops
+   {
+      using type = result<std::int64_t, std::errc>;
+
+      static auto success(std::int64_t i) noexcept -> type { return make_value(i); }
+      static auto failure() noexcept -> type { return make_error(std::errc::invalid_argument); }
+      static auto step(std::int64_t i) noexcept -> type
+      {
+         return i == failure_marker ? failure() : success(next(i));
+      }
+      static auto and_then(type&& m) noexcept -> type { return std::move(m).and_then(step); }
+      static auto map(type&& m) noexcept -> type { return std::move(m).map(next); }
+      static auto value_or(const type& m) noexcept -> std::int64_t
+      {
+         return m.value().value_or(0);
+      }
+   };
+
+   struct either_ops
+   {
+      using type = either<std::errc, std::int64_t>;
+
+      static auto success(std::int64_t i) noexcept -> type { return make_right(i); }
+      static auto failure() noexcept -> type { return make_left(std::errc::invalid_argument); }
+      static auto step(std::int64_t i) noexcept -> type
+      {
+         return i == failure_marker ? failure() : success(next(i));
+      }
+      static auto and_then(type&& m) noexcept -> type
+      {
+         return std::move(m).right_flat_map(step);
+      }
+      static auto map(type&& m) noexcept -> type { return std::move(m).right_map(next); }
+      static auto value_or(const type& m) noexcept -> std::int64_t
+      {
+         return m.right().value_or(0);
+      }
+   };
+
+   struct variant_ops
+   {
+      using type = std::variant<std::errc, std::int64_t>;
+
+      static auto success(std::int64_t i) noexcept -> type { return i; }
+      static auto failure() noexcept -> type { return std::errc::invalid_argument; }
+      static auto step(std::int64_t i) noexcept -> type
+      {
+         return i == failure_marker ? failure() : success(next(i));
+      }
+      static auto and_then(type&& m) noexcept -> type
+      {
+         const auto* value = std::get_if<1>(&m);
+         return value != nullptr ? step(*value) : std::move(m);
+      }
+      static auto map(type&& m) noexcept -> type
+      {
+         const auto* value = std::get_if<1>(&m);
+         return value != nullptr ? type{next(*value)} : std::move(m);
+      }
+      static auto value_or(const type& m) noexcept -> std::int64_t
+      {
+         const auto* value = std::get_if<1>(&m);
+         return value != nullptr ? *value : 0;
+      }
+   };
+
+#if defined(__cpp_lib_expected)
+   struct expected_ops
+   {
+      using type = std::expected<std::int64_t, std::errc>;
+
+      static auto success(std::int64_t i) noexcept -> type { return i; }
+      static auto failure() noexcept -> type
+      {
+         return std::unexpected{std::errc::invalid_argument};
+      }
+      static auto step(std::int64_t i) noexcept -> type
+      {
+         return i == failure_marker ? failure() : success(next(i));
+      }
+      static auto and_then(type&& m) noexcept -> type { return std::move(m).and_then(step); }
+      static auto map(type&& m) noexcept -> type { return std::move(m).transform(next); }
+      static auto value_or(const type& m) noexcept -> std::int64_t { return m.value_or(0); }
+   };
+#endif
+
+   /**
+    * Plain error codes: the value travels through an out parameter next to the returned code
+    */
+   struct errc_ops
+   {
+      struct type
+      {
+         std::errc code;
+         std::int64_t value;
+      };
+
+      static auto step(std::int64_t i, std::int64_t& out) noexcept -> std::errc
+      {
+         if (i == failure_marker)
+         {
+            return std::errc::invalid_argument;
+         }
+
+         out = next(i);
+
+         return std::errc{};
+      }
+
+      static auto success(std::int64_t i) noexcept -> type { return {std::errc{}, i}; }
+      static auto failure() noexcept -> type { return {std::errc::invalid_argument, 0}; }
+      static auto and_then(type&& m) noexcept -> type
+      {
+         if (m.code == std::errc{})
+         {
+            m.code = step(m.value, m.value);
+         }
+
+         return m;
+      }
+      static auto map(type&& m) noexcept -> type
+      {
+         if (m.code == std::errc{})
+         {
+            m.value = next(m.value);
+         }
+
+         return m;
+      }
+      static auto value_or(const type& m) noexcept -> std::int64_t
+      {
+         return m.code == std::errc{} ? m.value : 0;
+      }
+   };
+} // namespace
+
+template <class ops_>
+static void construct_value(benchmark::State& state)
+{
+   std::int64_t i = 0;
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      auto m = ops_::success(++i);
+      benchmark::DoNotOptimize(m);
+   }
+}
+
+template <class ops_>
+static void construct_error(benchmark::State& state)
+{
+   for ([[maybe_unused]] auto _ : state)
+   {
+      auto m = ops_::failure();
+      benchmark::DoNotOptimize(m);
+   }
+}
+
+template <class ops_>
+static void copy(benchmark::State& state)
+{
+   const auto source = ops_::success(42);
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      benchmark::DoNotOptimize(&source);
+      auto m = source;
+      benchmark::DoNotOptimize(m);
+   }
+}
+
+template <class ops_>
+static void move(benchmark::State& state)
+{
+   auto source = ops_::success(42);
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      benchmark::DoNotOptimize(source);
+      auto m = std::move(source);
+      benchmark::DoNotOptimize(m);
+      source = std::move(m);
+   }
+}
+
+/**
+ * state.range(0) successful and_then steps
+ */
+template <class ops_>
+static void and_then_chain(benchmark::State& state)
+{
+   std::int64_t i = 0;
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      benchmark::DoNotOptimize(i);
+      auto m = ops_::success(i++ & 0xFFFF);
+
+      for (std::int64_t depth = 0; depth < state.range(0); ++depth)
+      {
+         m = ops_::and_then(std::move(m));
+      }
+
+      benchmark::DoNotOptimize(m);
+   }
+}
+
+/**
+ * state.range(0) map steps
+ */
+template <class ops_>
+static void map_chain(benchmark::State& state)
+{
+   std::int64_t i = 0;
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      benchmark::DoNotOptimize(i);
+      auto m = ops_::success(i++ & 0xFFFF);
+
+      for (std::int64_t depth = 0; depth < state.range(0); ++depth)
+      {
+         m = ops_::map(std::move(m));
+      }
+
+      benchmark::DoNotOptimize(m);
+   }
+}
+
+/**
+ * An error raised by the first step and carried through the remaining state.range(0) - 1
+ */
+template <class ops_>
+static void error_propagation(benchmark::State& state)
+{
+   for ([[maybe_unused]] auto _ : state)
+   {
+      std::int64_t input = failure_marker;
+      benchmark::DoNotOptimize(input);
+      auto m = ops_::success(input);
+
+      for (std::int64_t depth = 0; depth < state.range(0); ++depth)
+      {
+         m = ops_::and_then(std::move(m));
+      }
+
+      benchmark::DoNotOptimize(m);
+   }
+}
+
+/**
+ * value_or over a mix of one failure for three values
+ */
+template <class ops_>
+static void value_or(benchmark::State& state)
+{
+   std::array<typename ops_::type, 4> inputs{ops_::success(1), ops_::success(2),
+                                             ops_::failure(), ops_::success(3)};
+   std::size_t i = 0;
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      benchmark::DoNotOptimize(inputs);
+      auto v = ops_::value_or(inputs[i++ & 3]);
+      benchmark::DoNotOptimize(v);
+   }
+}
+
+#define MONADS_BENCH_CARRIER(ops)                                                                 \
+   BENCHMARK_TEMPLATE(construct_value, ops);                                                      \
+   BENCHMARK_TEMPLATE(construct_error, ops);                                                      \
+   BENCHMARK_TEMPLATE(copy, ops);                                                                 \
+   BENCHMARK_TEMPLATE(move, ops);                                                                 \
+   BENCHMARK_TEMPLATE(and_then_chain, ops)->RangeMultiplier(4)->Range(1, 64);                     \
+   BENCHMARK_TEMPLATE(map_chain, ops)->RangeMultiplier(4)->Range(1, 64);                          \
+   BENCHMARK_TEMPLATE(error_propagation, ops)->RangeMultiplier(4)->Range(1, 64);                  \
+   BENCHMARK_TEMPLATE(value_or, ops)
+
+MONADS_BENCH_CARRIER(maybe_ops);
+MONADS_BENCH_CARRIER(optional_ops);
+MONADS_BENCH_CARRIER(result_ops);
+MONADS_BENCH_CARRIER(either_ops);
+MONADS_BENCH_CARRIER(variant_ops);
+MONADS_BENCH_CARRIER(errc_ops);
+#if defined(__cpp_lib_expected)
+MONADS_BENCH_CARRIER(expected_ops);
+#endif
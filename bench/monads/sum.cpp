@@ -0,0 +1,193 @@
+#include <monads/either.hpp>
+#include <monads/sum.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <variant>
+#include <vector>
+
+using namespace monad;
+
+namespace
+{
+   struct point
+   {
+      float x{0};
+      float y{0};
+   };
+
+   using token_sum = sum<std::int32_t, double, point, std::uint8_t, std::int64_t, float>;
+   using token_variant =
+      std::variant<std::int32_t, double, point, std::uint8_t, std::int64_t, float>;
+   using token_either = either<
+      std::int32_t,
+      either<double, either<point, either<std::uint8_t, either<std::int64_t, float>>>>>;
+
+   constexpr std::size_t token_count = 4096;
+
+   /**
+    * Tokens of every kind in random order, or grouped by kind when grouped is set so that the
+    * dispatch is predictable
+    */
+   template <class token_>
+   auto make_tokens(auto&& make, bool grouped) -> std::vector<token_>
+   {
+      std::mt19937 engine{42}; // NOLINT
+      std::uniform_int_distribution<int> pick{0, 5};
+
+      std::vector<int> kinds(token_count);
+      for (auto& kind : kinds)
+      {
+         kind = pick(engine);
+      }
+
+      if (grouped)
+      {
+         std::sort(kinds.begin(), kinds.end());
+      }
+
+      std::vector<token_> tokens;
+      tokens.reserve(token_count);
+
+      for (std::size_t i = 0; i < token_count; ++i)
+      {
+         tokens.push_back(make(kinds[i], static_cast<std::int32_t>(i)));
+      }
+
+      return tokens;
+   }
+
+   template <class token_>
+   auto make_flat(int kind, std::int32_t i) -> token_
+   {
+      switch (kind)
+      {
+         case 0:
+            return token_{std::in_place_index<0>, i};
+         case 1:
+            return token_{std::in_place_index<1>, i * 0.5};
+         case 2:
+            return token_{std::in_place_index<2>, point{float(i), 1.0F}};
+         case 3:
+            return token_{std::in_place_index<3>, static_cast<std::uint8_t>(i)};
+         case 4:
+            return token_{std::in_place_index<4>, std::int64_t{i} << 3};
+         default:
+            return token_{std::in_place_index<5>, float(i) * 0.25F};
+      }
+   }
+
+   auto make_nested(int kind, std::int32_t i) -> token_either
+   {
+      constexpr auto left = std::in_place_index<0>;
+      constexpr auto right = std::in_place_index<1>;
+
+      switch (kind)
+      {
+         case 0:
+            return token_either{left, i};
+         case 1:
+            return token_either{right, left, i * 0.5};
+         case 2:
+            return token_either{right, right, left, point{float(i), 1.0F}};
+         case 3:
+            return token_either{right, right, right, left, static_cast<std::uint8_t>(i)};
+         case 4:
+            return token_either{right, right, right, right, left, std::int64_t{i} << 3};
+         default:
+            return token_either{right, right, right, right, right, float(i) * 0.25F};
+      }
+   }
+
+   struct weigh
+   {
+      auto operator()(std::int32_t v) const noexcept -> double { return v; }
+      auto operator()(double v) const noexcept -> double { return v; }
+      auto operator()(point p) const noexcept -> double { return p.x + p.y; }
+      auto operator()(std::uint8_t v) const noexcept -> double { return v * 2.0; }
+      auto operator()(std::int64_t v) const noexcept -> double { return double(v); }
+      auto operator()(float v) const noexcept -> double { return v; }
+   };
+} // namespace
+
+static void sum_match(benchmark::State& state)
+{
+   const auto tokens = make_tokens<token_sum>(make_flat<token_sum>, state.range(0) != 0);
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      double total = 0;
+
+      for (const auto& token : tokens)
+      {
+         total += token.match(weigh{});
+      }
+
+      benchmark::DoNotOptimize(total);
+   }
+
+   state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(tokens.size()));
+}
+BENCHMARK(sum_match)->Arg(0)->Arg(1);
+
+static void nested_either_join(benchmark::State& state)
+{
+   const auto tokens = make_tokens<token_either>(make_nested, state.range(0) != 0);
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      double total = 0;
+
+      for (const auto& token : tokens)
+      {
+         total += token.join(weigh{}, [](const auto& e1) {
+            return e1.join(weigh{}, [](const auto& e2) {
+               return e2.join(weigh{}, [](const auto& e3) {
+                  return e3.join(weigh{}, [](const auto& e4) { return e4.join(weigh{}, weigh{}); });
+               });
+            });
+         });
+      }
+
+      benchmark::DoNotOptimize(total);
+   }
+
+   state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(tokens.size()));
+}
+BENCHMARK(nested_either_join)->Arg(0)->Arg(1);
+
+static void variant_visit(benchmark::State& state)
+{
+   const auto tokens = make_tokens<token_variant>(make_flat<token_variant>, state.range(0) != 0);
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      double total = 0;
+
+      for (const auto& token : tokens)
+      {
+         total += std::visit(weigh{}, token);
+      }
+
+      benchmark::DoNotOptimize(total);
+   }
+
+   state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(tokens.size()));
+}
+BENCHMARK(variant_visit)->Arg(0)->Arg(1);
+
+static void token_footprint(benchmark::State& state)
+{
+   for ([[maybe_unused]] auto _ : state)
+   {
+      benchmark::DoNotOptimize(sizeof(token_sum));
+   }
+
+   state.counters["sum"] = sizeof(token_sum);
+   state.counters["nested_either"] = sizeof(token_either);
+   state.counters["variant"] = sizeof(token_variant);
+}
+BENCHMARK(token_footprint);
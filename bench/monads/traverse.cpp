@@ -0,0 +1,164 @@
+#include <monads/traverse.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <ranges>
+#include <vector>
+
+using namespace monad;
+
+namespace
+{
+   auto checked(std::int64_t i) -> result<std::int64_t, int>
+   {
+      if (i < 0)
+      {
+         return make_error(static_cast<int>(i));
+      }
+
+      return make_value(i * 3);
+   }
+
+   auto make_inputs(std::int64_t count, std::int64_t failure_at) -> std::vector<std::int64_t>
+   {
+      std::vector<std::int64_t> inputs(static_cast<std::size_t>(count));
+
+      for (std::int64_t i = 0; i < count; ++i)
+      {
+         inputs[static_cast<std::size_t>(i)] = i == failure_at ? -1 : i;
+      }
+
+      return inputs;
+   }
+
+   /**
+    * The loop written at call sites before traverse existed
+    */
+   auto hand_written(auto&& inputs) -> result<std::vector<std::int64_t>, int>
+   {
+      std::vector<std::int64_t> values;
+
+      for (const std::int64_t i : inputs)
+      {
+         auto r = checked(i);
+
+         if (!r.is_value())
+         {
+            return make_error(*r.error_ptr());
+         }
+
+         values.push_back(*r.value_ptr());
+      }
+
+      return make_value(std::move(values));
+   }
+
+   const auto keep_all = [](std::int64_t) { return true; };
+} // namespace
+
+static void traverse_sized(benchmark::State& state)
+{
+   const auto inputs = make_inputs(state.range(0), -1);
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      auto r = traverse(inputs, checked);
+      benchmark::DoNotOptimize(r);
+   }
+
+   state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(traverse_sized)->Arg(64)->Arg(4096)->Arg(262144);
+
+static void hand_written_sized(benchmark::State& state)
+{
+   const auto inputs = make_inputs(state.range(0), -1);
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      auto r = hand_written(inputs);
+      benchmark::DoNotOptimize(r);
+   }
+
+   state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(hand_written_sized)->Arg(64)->Arg(4096)->Arg(262144);
+
+static void traverse_unsized(benchmark::State& state)
+{
+   const auto inputs = make_inputs(state.range(0), -1);
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      auto r = traverse(inputs | std::views::filter(keep_all), checked);
+      benchmark::DoNotOptimize(r);
+   }
+
+   state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(traverse_unsized)->Arg(64)->Arg(4096)->Arg(262144);
+
+static void hand_written_unsized(benchmark::State& state)
+{
+   const auto inputs = make_inputs(state.range(0), -1);
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      auto r = hand_written(inputs | std::views::filter(keep_all));
+      benchmark::DoNotOptimize(r);
+   }
+
+   state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(hand_written_unsized)->Arg(64)->Arg(4096)->Arg(262144);
+
+static void sequence_moved(benchmark::State& state)
+{
+   const auto inputs = make_inputs(state.range(0), -1);
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      state.PauseTiming();
+      std::vector<result<std::int64_t, int>> results;
+      results.reserve(inputs.size());
+      for (const std::int64_t i : inputs)
+      {
+         results.push_back(checked(i));
+      }
+      state.ResumeTiming();
+
+      auto r = sequence(std::move(results));
+      benchmark::DoNotOptimize(r);
+   }
+
+   state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(sequence_moved)->Arg(4096);
+
+/**
+ * The error sits at index 16, the rest of the input must not be visited
+ */
+static void traverse_early_failure(benchmark::State& state)
+{
+   const auto inputs = make_inputs(state.range(0), 16);
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      auto r = traverse(inputs, checked);
+      benchmark::DoNotOptimize(r);
+   }
+}
+BENCHMARK(traverse_early_failure)->Arg(4096)->Arg(262144);
+
+static void hand_written_early_failure(benchmark::State& state)
+{
+   const auto inputs = make_inputs(state.range(0), 16);
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      auto r = hand_written(inputs);
+      benchmark::DoNotOptimize(r);
+   }
+}
+BENCHMARK(hand_written_early_failure)->Arg(4096)->Arg(262144);
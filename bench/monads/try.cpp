@@ -0,0 +1,109 @@
+#include <monads/try.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace monad;
+
+namespace
+{
+   /**
+    * try_wrap as it was before the callable was forwarded and the exception moved
+    */
+   template <class error_, class... args_>
+   auto copying_try_wrap(const std::invocable<args_...> auto& fun, args_&&... args)
+      -> result<std::invoke_result_t<decltype(fun), args_...>, error_>
+   {
+      try
+      {
+         return make_value(std::invoke(fun, std::forward<args_>(args)...));
+      }
+      catch (const error_& e)
+      {
+         return make_error(e);
+      }
+   }
+
+   struct service_error
+   {
+      std::string message;
+      std::vector<std::string> context;
+   };
+
+   auto checksum(std::int64_t i) noexcept -> std::int64_t
+   {
+      return (i * 0x9E3779B97F4A7C15LL) >> 7;
+   }
+
+   [[gnu::noinline]] auto remote_call(std::int64_t i) -> std::int64_t
+   {
+      if (i < 0)
+      {
+         throw service_error{"remote call failed with a fairly long diagnostic message",
+                             {"connection pool", "request handler", "serializer"}};
+      }
+
+      return i + 1;
+   }
+} // namespace
+
+static void try_wrap_noexcept(benchmark::State& state)
+{
+   std::int64_t sum = 0;
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      for (std::int64_t i = 0; i < 1024; ++i)
+      {
+         sum += *try_wrap<service_error>(checksum, i).value_ptr();
+      }
+
+      benchmark::DoNotOptimize(sum);
+   }
+}
+BENCHMARK(try_wrap_noexcept);
+
+static void copying_try_wrap_noexcept(benchmark::State& state)
+{
+   std::int64_t sum = 0;
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      for (std::int64_t i = 0; i < 1024; ++i)
+      {
+         sum += *copying_try_wrap<service_error>(checksum, i).value_ptr();
+      }
+
+      benchmark::DoNotOptimize(sum);
+   }
+}
+BENCHMARK(copying_try_wrap_noexcept);
+
+static void try_wrap_throwing(benchmark::State& state)
+{
+   std::int64_t i = -1;
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      benchmark::DoNotOptimize(i);
+      auto r = try_wrap<service_error>(remote_call, i);
+      benchmark::DoNotOptimize(r);
+   }
+}
+BENCHMARK(try_wrap_throwing);
+
+static void copying_try_wrap_throwing(benchmark::State& state)
+{
+   std::int64_t i = -1;
+
+   for ([[maybe_unused]] auto _ : state)
+   {
+      benchmark::DoNotOptimize(i);
+      auto r = copying_try_wrap<service_error>(remote_call, i);
+      benchmark::DoNotOptimize(r);
+   }
+}
+BENCHMARK(copying_try_wrap_throwing);
@@ -0,0 +1,16 @@
+#pragma once
+
+// ABI of the library. Instrumentation changes the bodies of templates whose signatures it leaves
+// unchanged, so when MONADS_INSTRUMENT is defined the whole library is declared in the inline
+// namespace monad::instrumented. Every entity then mangles differently from its plain build:
+// instrumented and plain translation units each get their own instantiations instead of the
+// linker keeping one of two different bodies, and a function passing library types between the
+// two builds fails to link. Plain builds add no namespace.
+
+#if defined(MONADS_INSTRUMENT)
+#  define MONADS_ABI_BEGIN inline namespace instrumented {
+#  define MONADS_ABI_END }
+#else
+#  define MONADS_ABI_BEGIN
+#  define MONADS_ABI_END
+#endif
@@ -0,0 +1,83 @@
+#pragma once
+
+// Allocator propagation of the payloads. maybe, either and result use an allocator when one of
+// their payloads does, and take it through allocator-extended constructors, so that containers
+// and arenas built on std::pmr construct them with uses-allocator construction. Copying an
+// allocator aware payload through the copy constructor selects a new allocator, which for
+// std::pmr types is the default memory resource. The combinators copy payloads with the
+// allocator of the payload they copy instead, so that the values and errors flowing through a
+// pipeline stay in the memory resource they were built in.
+
+#include "monads/abi.hpp"
+
+#include <concepts>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace monad
+{
+   MONADS_ABI_BEGIN
+
+   namespace detail
+   {
+      template <class any_>
+      using allocator_of =
+         std::remove_cvref_t<decltype(std::declval<const any_&>().get_allocator())>;
+
+      // clang-format off
+      /**
+       * A type exposing the allocator it was built with, and which can be built with one. Types
+       * whose allocators always compare equal, like std::allocator, gain nothing from keeping
+       * theirs
+       */
+      template <class any_>
+      concept allocator_aware = requires(const any_& value)
+      {
+         value.get_allocator();
+      } && std::uses_allocator_v<any_, allocator_of<any_>> &&
+         !std::allocator_traits<allocator_of<any_>>::is_always_equal::value;
+      // clang-format on
+
+      /**
+       * Forward a payload to a constructor. Payloads that would be copied are copied with the
+       * allocator of the source if they are allocator aware, anything else is forwarded unchanged
+       */
+      template <class any_>
+      constexpr auto keep_allocator(any_&& source) -> decltype(auto)
+      {
+         using value_type = std::remove_cvref_t<any_>;
+
+         constexpr bool copied =
+            std::is_lvalue_reference_v<any_> || std::is_const_v<std::remove_reference_t<any_>>;
+
+         if constexpr (copied && allocator_aware<value_type>)
+         {
+            return std::make_obj_using_allocator<value_type>(source.get_allocator(), source);
+         }
+         else
+         {
+            return std::forward<any_>(source);
+         }
+      }
+
+      /**
+       * Build a value with uses-allocator construction. Used with from_invoke so that the value is
+       * constructed in place in the storage
+       */
+      template <class any_>
+      struct construct_using_allocator_t
+      {
+         constexpr auto operator()(const auto& allocator, auto&&... args) const -> any_
+         {
+            return std::make_obj_using_allocator<any_>(allocator,
+                                                       std::forward<decltype(args)>(args)...);
+         }
+      };
+
+      template <class any_>
+      inline constexpr construct_using_allocator_t<any_> construct_using_allocator{};
+   } // namespace detail
+
+   MONADS_ABI_END
+} // namespace monad
@@ -0,0 +1,446 @@
+#pragma once
+
+#include "monads/abi.hpp"
+#include "monads/either.hpp"
+#include "monads/maybe.hpp"
+#include "monads/result.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <ranges>
+#include <span>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<sys/mman.h>)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#  define MONADS_HAS_MMAP 1
+#endif
+
+/**
+ * Binary layout of maybe, result and either over trivially copyable payloads, as stored in files
+ * written by write_binary and mapped by mapped_array. All integers are little-endian and the
+ * layout is only provided on little-endian targets.
+ *
+ * A file starts with a 64 byte binary_header, followed by the elements back to back, each one
+ * sizeof(M) bytes long and aligned to alignof(M), which is at most 64.
+ *
+ * Within an element, the payload, or the active one of the two payloads, starts at offset 0. The
+ * tag is a single byte right after the larger payload, at offset max(sizeof(first),
+ * sizeof(second)), and holds 0 or 1:
+ *
+ *    maybe<T>       1 when a value is stored. No tag when T has a niche: the element is a T and
+ *                   the empty state is the niche of T
+ *    result<T, E>   1 when an error is stored, T is the first payload and E the second
+ *    either<L, R>   1 when the right side is stored, L is the first payload and R the second
+ *
+ * The bytes that belong to neither the active payload nor the tag are written as zero.
+ */
+
+namespace monad
+{
+   MONADS_ABI_BEGIN
+
+   enum class binary_kind : std::uint32_t
+   {
+      maybe = 1,
+      result = 2,
+      either = 3
+   };
+
+   /**
+    * The description of a binary_layout, checked against the file header when a file is mapped
+    */
+   struct binary_header
+   {
+      static constexpr std::array<char, 8> expected_magic{'m', 'o', 'n', 'a', 'd', 's', '\0', '\1'};
+      static constexpr std::uint32_t current_version = 1;
+      static constexpr std::uint32_t no_tag = 0xFFFFFFFF;
+
+      std::array<char, 8> magic{expected_magic};
+      std::uint32_t version{current_version};
+      binary_kind kind{};
+      std::uint32_t element_size{0};
+      std::uint32_t element_alignment{0};
+      std::uint32_t tag_offset{no_tag};
+      std::uint32_t first_size{0};
+      std::uint32_t second_size{0};
+      std::uint32_t reserved{0};
+      std::uint64_t count{0};
+      std::array<std::byte, 16> padding{};
+
+      constexpr auto operator==(const binary_header&) const -> bool = default;
+   };
+
+   static_assert(sizeof(binary_header) == 64 && alignof(binary_header) <= 64);
+   static_assert(std::is_trivially_copyable_v<binary_header>);
+
+   /**
+    * Describes the binary layout of a monad. Only the specializations below are provided, for
+    * the monads whose payloads are trivially copyable
+    */
+   template <class monad_>
+   struct binary_layout;
+
+   namespace detail
+   {
+      /**
+       * The parts of a layout that are the same for every monad with two payloads and a tag
+       */
+      template <class monad_, binary_kind kind_, class first_, class second_>
+      struct tagged_binary_layout
+      {
+         static_assert(std::endian::native == std::endian::little,
+                       "the binary layout of the monads is little-endian");
+         static_assert(std::is_trivially_copyable_v<monad_> && std::is_standard_layout_v<monad_>);
+         static_assert(alignof(monad_) <= sizeof(binary_header),
+                       "the elements are aligned by the size of the header");
+
+         static constexpr binary_kind kind = kind_;
+         static constexpr std::size_t tag_offset = std::max(sizeof(first_), sizeof(second_));
+         static constexpr std::size_t first_size = sizeof(first_);
+         static constexpr std::size_t second_size = sizeof(second_);
+
+         static_assert(alignof(monad_) == std::max(alignof(first_), alignof(second_)),
+                       "the payloads are expected at offset 0");
+         static_assert(sizeof(monad_) == (tag_offset + alignof(monad_)) / alignof(monad_) *
+                          alignof(monad_),
+                       "the tag is expected right after the larger payload");
+         static_assert(sizeof(bool) == 1);
+      };
+
+      template <class monad_>
+      concept has_binary_layout = requires { binary_layout<monad_>::kind; };
+   } // namespace detail
+
+   template <class value_>
+      requires std::is_trivially_copyable_v<value_> && (!has_niche<value_>)
+   struct binary_layout<maybe<value_>> :
+      detail::tagged_binary_layout<maybe<value_>, binary_kind::maybe, value_, value_>
+   {
+      static constexpr auto tag(const maybe<value_>& m) noexcept -> bool { return m.has_value(); }
+      static constexpr auto active_size(const maybe<value_>& m) noexcept -> std::size_t
+      {
+         return m.has_value() ? sizeof(value_) : 0;
+      }
+   };
+
+   template <class value_>
+      requires std::is_trivially_copyable_v<value_> && has_niche<value_>
+   struct binary_layout<maybe<value_>>
+   {
+      static_assert(std::endian::native == std::endian::little,
+                    "the binary layout of the monads is little-endian");
+      static_assert(sizeof(maybe<value_>) == sizeof(value_));
+      static_assert(alignof(value_) <= sizeof(binary_header),
+                    "the elements are aligned by the size of the header");
+
+      static constexpr binary_kind kind = binary_kind::maybe;
+      static constexpr std::size_t tag_offset = binary_header::no_tag;
+      static constexpr std::size_t first_size = sizeof(value_);
+      static constexpr std::size_t second_size = sizeof(value_);
+
+      static constexpr auto active_size(const maybe<value_>&) noexcept -> std::size_t
+      {
+         return sizeof(value_);
+      }
+   };
+
+   template <class value_, class error_>
+      requires std::is_trivially_copyable_v<value_> && std::is_trivially_copyable_v<error_>
+   struct binary_layout<result<value_, error_>> :
+      detail::tagged_binary_layout<result<value_, error_>, binary_kind::result, value_, error_>
+   {
+      static constexpr auto tag(const result<value_, error_>& r) noexcept -> bool
+      {
+         return !r.is_value();
+      }
+      static constexpr auto active_size(const result<value_, error_>& r) noexcept -> std::size_t
+      {
+         return r.is_value() ? sizeof(value_) : sizeof(error_);
+      }
+   };
+
+   template <class left_, class right_>
+      requires std::is_trivially_copyable_v<left_> && std::is_trivially_copyable_v<right_>
+   struct binary_layout<either<left_, right_>> :
+      detail::tagged_binary_layout<either<left_, right_>, binary_kind::either, left_, right_>
+   {
+      static constexpr auto tag(const either<left_, right_>& e) noexcept -> bool
+      {
+         return e.is_right();
+      }
+      static constexpr auto active_size(const either<left_, right_>& e) noexcept -> std::size_t
+      {
+         return e.is_right() ? sizeof(right_) : sizeof(left_);
+      }
+   };
+
+   /**
+    * The header of a file holding count elements of type monad_
+    */
+   template <class monad_>
+      requires detail::has_binary_layout<monad_>
+   constexpr auto make_binary_header(std::uint64_t count) noexcept -> binary_header
+   {
+      using layout = binary_layout<monad_>;
+
+      binary_header header;
+      header.kind = layout::kind;
+      header.element_size = sizeof(monad_);
+      header.element_alignment = alignof(monad_);
+      header.tag_offset = static_cast<std::uint32_t>(layout::tag_offset);
+      header.first_size = static_cast<std::uint32_t>(layout::first_size);
+      header.second_size = static_cast<std::uint32_t>(layout::second_size);
+      header.count = count;
+
+      return header;
+   }
+
+   /**
+    * Copy the elements into a buffer of the same size in their binary layout, with the bytes of
+    * the inactive payload and the padding set to zero
+    */
+   template <class monad_>
+      requires detail::has_binary_layout<monad_>
+   void to_binary(std::span<const monad_> elements, std::span<std::byte> out) noexcept
+   {
+      using layout = binary_layout<monad_>;
+
+      std::memset(out.data(), 0, elements.size_bytes());
+
+      for (std::size_t i = 0; i < elements.size(); ++i)
+      {
+         std::byte* record = out.data() + i * sizeof(monad_);
+         const auto* source = reinterpret_cast<const std::byte*>(&elements[i]); // NOLINT
+
+         std::memcpy(record, source, layout::active_size(elements[i]));
+
+         if constexpr (layout::tag_offset != binary_header::no_tag)
+         {
+            record[layout::tag_offset] = std::byte{layout::tag(elements[i])};
+         }
+      }
+   }
+
+   // clang-format off
+   template <class range_>
+      requires std::ranges::contiguous_range<const range_> &&
+         std::ranges::sized_range<const range_> &&
+         detail::has_binary_layout<std::ranges::range_value_t<range_>>
+   void to_binary(const range_& elements, std::span<std::byte> out) noexcept
+   // clang-format on
+   {
+      to_binary(std::span<const std::ranges::range_value_t<range_>>{elements}, out);
+   }
+
+   /**
+    * Write a header and the elements of a contiguous range in their binary layout to a file
+    */
+   // clang-format off
+   template <class range_>
+      requires std::ranges::contiguous_range<const range_> &&
+         std::ranges::sized_range<const range_> &&
+         detail::has_binary_layout<std::ranges::range_value_t<range_>>
+   auto write_binary(const char* path, const range_& range) -> result<void, std::errc>
+   // clang-format on
+   {
+      using monad_ = std::ranges::range_value_t<range_>;
+
+      const std::span<const monad_> elements{range};
+      constexpr std::size_t batch = std::max<std::size_t>(1, 16384 / sizeof(monad_));
+
+      std::FILE* file = std::fopen(path, "wb");
+      if (file == nullptr)
+      {
+         return make_error(std::errc{errno});
+      }
+
+      const binary_header header = make_binary_header<monad_>(elements.size());
+      bool written = std::fwrite(&header, sizeof(header), 1, file) == 1;
+
+      alignas(monad_) std::array<std::byte, batch * sizeof(monad_)> buffer; // NOLINT
+
+      for (std::size_t first = 0; written && first < elements.size(); first += batch)
+      {
+         const auto chunk = elements.subspan(first, std::min(batch, elements.size() - first));
+
+         to_binary(chunk, std::span{buffer});
+         written = std::fwrite(buffer.data(), sizeof(monad_), chunk.size(), file) == chunk.size();
+      }
+
+      if (std::fclose(file) != 0 || !written)
+      {
+         return make_error(std::errc::io_error);
+      }
+
+      return make_value();
+   }
+
+   /**
+    * How much of a file is checked when it is mapped: only the header, or also every tag, which
+    * reads one byte per element
+    */
+   enum class binary_check
+   {
+      header,
+      tags
+   };
+
+#if defined(MONADS_HAS_MMAP)
+   /**
+    * A read-only view of a file written by write_binary, mapped in memory. The elements are used
+    * in place, without being copied or converted
+    */
+   template <class monad_>
+      requires detail::has_binary_layout<monad_>
+   class mapped_array
+   {
+   public:
+      mapped_array(const mapped_array&) = delete;
+      mapped_array(mapped_array&& other) noexcept :
+         m_mapping{std::exchange(other.m_mapping, nullptr)},
+         m_mapping_size{std::exchange(other.m_mapping_size, 0)},
+         m_elements{std::exchange(other.m_elements, {})}
+      {}
+      ~mapped_array()
+      {
+         if (m_mapping != nullptr)
+         {
+            ::munmap(m_mapping, m_mapping_size);
+         }
+      }
+
+      auto operator=(const mapped_array&) -> mapped_array& = delete;
+      auto operator=(mapped_array&& other) noexcept -> mapped_array&
+      {
+         std::swap(m_mapping, other.m_mapping);
+         std::swap(m_mapping_size, other.m_mapping_size);
+         std::swap(m_elements, other.m_elements);
+
+         return *this;
+      }
+
+      /**
+       * Map a file, failing with std::errc::invalid_argument if its header does not describe
+       * elements of type monad_ or its size does not match the header
+       */
+      static auto open(const char* path, binary_check check = binary_check::header)
+         -> result<mapped_array, std::errc>
+      {
+         const int fd = ::open(path, O_RDONLY | O_CLOEXEC); // NOLINT
+         if (fd < 0)
+         {
+            return make_error(std::errc{errno});
+         }
+
+         struct stat status
+         {
+         };
+         if (::fstat(fd, &status) != 0)
+         {
+            const int error = errno;
+            ::close(fd);
+
+            return make_error(std::errc{error});
+         }
+
+         const auto size = static_cast<std::size_t>(status.st_size);
+         if (size < sizeof(binary_header))
+         {
+            ::close(fd);
+
+            return make_error(std::errc::invalid_argument);
+         }
+
+         void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+         const int error = errno;
+         ::close(fd);
+
+         if (mapping == MAP_FAILED) // NOLINT
+         {
+            return make_error(std::errc{error});
+         }
+
+         mapped_array array{mapping, size};
+
+         if (!array.attach(check))
+         {
+            return make_error(std::errc::invalid_argument);
+         }
+
+         return make_value(std::move(array));
+      }
+
+      [[nodiscard]] auto elements() const noexcept -> std::span<const monad_> { return m_elements; }
+      [[nodiscard]] auto size() const noexcept -> std::size_t { return m_elements.size(); }
+
+      auto operator[](std::size_t i) const noexcept -> const monad_& { return m_elements[i]; }
+
+      [[nodiscard]] auto begin() const noexcept { return m_elements.begin(); }
+      [[nodiscard]] auto end() const noexcept { return m_elements.end(); }
+
+   private:
+      mapped_array(void* mapping, std::size_t size) noexcept :
+         m_mapping{mapping}, m_mapping_size{size}
+      {}
+
+      auto attach(binary_check check) noexcept -> bool
+      {
+         using layout = binary_layout<monad_>;
+
+         const auto* bytes = static_cast<const std::byte*>(m_mapping);
+
+         binary_header header;
+         std::memcpy(&header, bytes, sizeof(header));
+
+         if (header != make_binary_header<monad_>(header.count) ||
+             header.count > (m_mapping_size - sizeof(header)) / sizeof(monad_) ||
+             sizeof(header) + header.count * sizeof(monad_) != m_mapping_size)
+         {
+            return false;
+         }
+
+         const std::byte* first = bytes + sizeof(header);
+
+         if constexpr (layout::tag_offset != binary_header::no_tag)
+         {
+            if (check == binary_check::tags)
+            {
+               for (std::size_t i = 0; i < header.count; ++i)
+               {
+                  if (std::to_integer<unsigned>(first[i * sizeof(monad_) + layout::tag_offset]) >
+                      1)
+                  {
+                     return false;
+                  }
+               }
+            }
+         }
+
+         m_elements = {std::launder(reinterpret_cast<const monad_*>(first)), // NOLINT
+                       static_cast<std::size_t>(header.count)};
+
+         return true;
+      }
+
+   private:
+      void* m_mapping{nullptr};
+      std::size_t m_mapping_size{0};
+      std::span<const monad_> m_elements;
+   };
+#endif
+
+   MONADS_ABI_END
+} // namespace monad
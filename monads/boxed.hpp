@@ -0,0 +1,308 @@
+#pragma once
+
+#include <monads/abi.hpp>
+#include <monads/result.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace monad
+{
+   MONADS_ABI_BEGIN
+
+   namespace detail
+   {
+      /**
+       * A pool of fixed size blocks shared by every type with the same size and alignment. Each
+       * thread keeps a small cache of free blocks in front of a shared free list, so that bursts
+       * of allocations and deallocations do not reach the global allocator. Chunks are only
+       * returned to the global allocator when the program exits
+       */
+      template <std::size_t size_, std::size_t align_>
+      class block_pool
+      {
+         struct node
+         {
+            node* next;
+         };
+
+         static constexpr std::size_t alignment = std::max(align_, alignof(node));
+         static constexpr std::size_t block_size =
+            (std::max(size_, sizeof(node)) + alignment - 1) / alignment * alignment;
+         static constexpr std::size_t blocks_per_chunk = 64;
+         static constexpr std::size_t cache_limit = 2 * blocks_per_chunk;
+
+         struct shared_state
+         {
+            shared_state() = default;
+            shared_state(const shared_state&) = delete;
+            shared_state(shared_state&&) = delete;
+            ~shared_state()
+            {
+               for (void* chunk : chunks)
+               {
+                  ::operator delete(chunk, std::align_val_t{alignment});
+               }
+            }
+
+            auto operator=(const shared_state&) -> shared_state& = delete;
+            auto operator=(shared_state&&) -> shared_state& = delete;
+
+            std::mutex mutex;
+            node* free{nullptr};
+            std::vector<void*> chunks;
+         };
+
+         struct local_cache
+         {
+            local_cache() = default;
+            local_cache(const local_cache&) = delete;
+            local_cache(local_cache&&) = delete;
+            ~local_cache() { release(head, count); }
+
+            auto operator=(const local_cache&) -> local_cache& = delete;
+            auto operator=(local_cache&&) -> local_cache& = delete;
+
+            node* head{nullptr};
+            std::size_t count{0};
+         };
+
+      public:
+         /**
+          * Take a block from the calling thread's cache, refilling it from the shared free list
+          * or from a new chunk when it is empty
+          */
+         static auto allocate() -> void*
+         {
+            local_cache& local = cache();
+
+            if (local.head == nullptr)
+            {
+               refill(local);
+            }
+
+            node* block = local.head;
+            local.head = block->next;
+            --local.count;
+
+            return block;
+         }
+
+         /**
+          * Return a block to the calling thread's cache, half of the cache is handed back to the
+          * shared free list once it grows past its limit
+          */
+         static void deallocate(void* pointer) noexcept
+         {
+            local_cache& local = cache();
+
+            auto* block = static_cast<node*>(pointer);
+            block->next = local.head;
+            local.head = block;
+
+            if (++local.count > cache_limit)
+            {
+               node* first = local.head;
+               node* last = first;
+               for (std::size_t i = 1; i < cache_limit / 2; ++i)
+               {
+                  last = last->next;
+               }
+
+               local.head = last->next;
+               local.count -= cache_limit / 2;
+
+               last->next = nullptr;
+               release(first, cache_limit / 2);
+            }
+         }
+
+         /**
+          * The number of chunks requested from the global allocator so far
+          */
+         static auto chunk_count() -> std::size_t
+         {
+            shared_state& state = shared();
+            const std::scoped_lock lock{state.mutex};
+
+            return state.chunks.size();
+         }
+
+      private:
+         static auto shared() -> shared_state&
+         {
+            static shared_state state;
+
+            return state;
+         }
+
+         static auto cache() -> local_cache&
+         {
+            // the shared state must outlive the thread local caches that flush into it
+            shared();
+
+            thread_local local_cache local;
+
+            return local;
+         }
+
+         static void refill(local_cache& local)
+         {
+            shared_state& state = shared();
+            const std::scoped_lock lock{state.mutex};
+
+            if (state.free == nullptr)
+            {
+               state.chunks.reserve(state.chunks.size() + 1);
+
+               auto* chunk = static_cast<std::byte*>(
+                  ::operator new(block_size * blocks_per_chunk, std::align_val_t{alignment}));
+               state.chunks.push_back(chunk);
+
+               for (std::size_t i = 0; i < blocks_per_chunk; ++i)
+               {
+                  auto* block = ::new (chunk + i * block_size) node{state.free};
+                  state.free = block;
+               }
+            }
+
+            for (std::size_t i = 0; i < blocks_per_chunk && state.free != nullptr; ++i)
+            {
+               node* block = state.free;
+               state.free = block->next;
+
+               block->next = local.head;
+               local.head = block;
+               ++local.count;
+            }
+         }
+
+         static void release(node* first, std::size_t count) noexcept
+         {
+            if (first == nullptr)
+            {
+               return;
+            }
+
+            node* last = first;
+            for (std::size_t i = 1; i < count; ++i)
+            {
+               last = last->next;
+            }
+
+            shared_state& state = shared();
+            const std::scoped_lock lock{state.mutex};
+
+            last->next = state.free;
+            state.free = first;
+         }
+      };
+   } // namespace detail
+
+   /**
+    * Owns a value stored out of line in a pooled block. Used as the error type of a result, it
+    * keeps sizeof(result<T, boxed<E>>) close to sizeof(T) regardless of the size of E, at the
+    * price of an allocation from the pool when an error is created. A moved-from boxed is empty
+    * and may only be assigned to or destroyed
+    */
+   template <class any_>
+   class boxed
+   {
+      using pool = detail::block_pool<sizeof(any_), alignof(any_)>;
+
+   public:
+      using value_type = any_;
+
+      boxed(const value_type& value) : boxed{std::in_place, value} {}
+      boxed(value_type&& value) : boxed{std::in_place, std::move(value)} {}
+      template <class... args_>
+         requires std::constructible_from<value_type, args_...>
+      explicit boxed(std::in_place_t, args_&&... args)
+      {
+         void* block = pool::allocate();
+
+         try
+         {
+            m_pointer = std::construct_at(static_cast<value_type*>(block),
+                                          std::forward<args_>(args)...);
+         }
+         catch (...)
+         {
+            pool::deallocate(block);
+            throw;
+         }
+      }
+      boxed(const boxed& rhs) requires std::copy_constructible<value_type> :
+         boxed{std::in_place, *rhs}
+      {}
+      boxed(boxed&& rhs) noexcept : m_pointer{std::exchange(rhs.m_pointer, nullptr)} {}
+      ~boxed() { reset(); }
+
+      auto operator=(const boxed& rhs) -> boxed& requires std::copy_constructible<value_type>
+      {
+         if (this != &rhs)
+         {
+            boxed copy{rhs};
+            swap(copy);
+         }
+
+         return *this;
+      }
+      auto operator=(boxed&& rhs) noexcept -> boxed&
+      {
+         if (this != &rhs)
+         {
+            reset();
+            m_pointer = std::exchange(rhs.m_pointer, nullptr);
+         }
+
+         return *this;
+      }
+
+      auto operator*() const noexcept -> const value_type& { return *m_pointer; }
+      auto operator*() noexcept -> value_type& { return *m_pointer; }
+      auto operator->() const noexcept -> const value_type* { return m_pointer; }
+      auto operator->() noexcept -> value_type* { return m_pointer; }
+
+      [[nodiscard]] auto get() const noexcept -> const value_type* { return m_pointer; }
+      [[nodiscard]] auto get() noexcept -> value_type* { return m_pointer; }
+
+      void swap(boxed& other) noexcept { std::swap(m_pointer, other.m_pointer); }
+
+      friend auto operator==(const boxed& lhs, const boxed& rhs) -> bool
+      {
+         return *lhs == *rhs;
+      }
+
+   private:
+      void reset() noexcept
+      {
+         if (m_pointer != nullptr)
+         {
+            std::destroy_at(m_pointer);
+            pool::deallocate(m_pointer);
+            m_pointer = nullptr;
+         }
+      }
+
+   private:
+      value_type* m_pointer{nullptr};
+   };
+
+   /**
+    * Build the error of a result<T, boxed<E>> from a value of E
+    */
+   template <class any_>
+   auto make_boxed_error(any_&& value) -> error_t<boxed<std::decay_t<any_>>>
+   {
+      return error_t<boxed<std::decay_t<any_>>>{
+         boxed<std::decay_t<any_>>{std::in_place, std::forward<any_>(value)}};
+   }
+
+   MONADS_ABI_END
+} // namespace monad
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "monads/abi.hpp"
+#include "monads/likelihood.hpp"
+
+#include <array>
+#include <cstddef>
+#include <source_location>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace monad
+{
+   MONADS_ABI_BEGIN
+
+   /**
+    * What was being done when an error went through a layer, and where. The description is not
+    * copied and must outlive the error, as string literals do
+    */
+   struct context_frame
+   {
+      const char* what;
+      std::source_location where;
+   };
+
+   /**
+    * An error together with the context frames attached to it on its way up, stored inline. The
+    * first capacity_ frames are kept, innermost first, and the frames attached after them are
+    * only counted. A contextual error owns nothing besides the error, it is trivially copyable
+    * when the error is
+    */
+   template <class error_, std::size_t capacity_ = 4>
+   class contextual
+   {
+      static_assert(capacity_ > 0);
+
+   public:
+      using error_type = error_;
+
+      static constexpr std::size_t capacity = capacity_;
+
+      constexpr contextual(const error_type& error, const context_frame& frame) noexcept(
+         std::is_nothrow_copy_constructible_v<error_type>) :
+         m_error(error)
+      {
+         push(frame);
+      }
+      constexpr contextual(error_type&& error, const context_frame& frame) noexcept(
+         std::is_nothrow_move_constructible_v<error_type>) :
+         m_error(std::move(error))
+      {
+         push(frame);
+      }
+
+      constexpr auto error() & noexcept -> error_type& { return m_error; }
+      constexpr auto error() const& noexcept -> const error_type& { return m_error; }
+      constexpr auto error() && noexcept -> error_type&& { return std::move(m_error); }
+      constexpr auto error() const&& noexcept -> const error_type&& { return std::move(m_error); }
+
+      /**
+       * The frames kept, from the innermost layer outwards
+       */
+      [[nodiscard]] constexpr auto frames() const noexcept -> std::span<const context_frame>
+      {
+         return {m_frames.data(), m_count < capacity ? m_count : capacity};
+      }
+
+      /**
+       * The number of frames attached once the buffer was full
+       */
+      [[nodiscard]] constexpr auto omitted() const noexcept -> std::size_t
+      {
+         return m_count < capacity ? 0 : m_count - capacity;
+      }
+
+      constexpr void push(const context_frame& frame) noexcept
+      {
+         if (m_count < capacity)
+         {
+            m_frames[m_count] = frame;
+         }
+
+         ++m_count;
+      }
+
+   private:
+      error_type m_error;
+      std::array<context_frame, capacity> m_frames{};
+      std::size_t m_count{0};
+   };
+
+   namespace detail
+   {
+      template <class error_>
+      struct contextual_error
+      {
+         using type = contextual<error_>;
+      };
+
+      template <class error_, std::size_t capacity_>
+      struct contextual_error<contextual<error_, capacity_>>
+      {
+         using type = contextual<error_, capacity_>;
+      };
+
+      /**
+       * The error of a result once context is attached to it: errors already carrying context keep
+       * their type, the others become contextual
+       */
+      template <class error_>
+      using contextual_error_t = typename contextual_error<error_>::type;
+
+      template <class error_>
+      constexpr auto with_frame(error_&& error, const context_frame& frame)
+         -> contextual_error_t<std::remove_cvref_t<error_>>
+      {
+         using contextual_type = contextual_error_t<std::remove_cvref_t<error_>>;
+
+         if constexpr (std::is_same_v<contextual_type, std::remove_cvref_t<error_>>)
+         {
+            contextual_type out{std::forward<error_>(error)};
+            out.push(frame);
+
+            return out;
+         }
+         else
+         {
+            return {std::forward<error_>(error), frame};
+         }
+      }
+
+      /**
+       * Build the failed result with the frame attached, out of line and cold like forwarded
+       * errors, so that attaching context leaves the success path unchanged
+       */
+      template <class out_, class error_>
+      MONADS_COLD constexpr auto attach_context(error_&& error, const context_frame& frame) -> out_
+      {
+         return {std::in_place_index<1>, with_frame(std::forward<error_>(error), frame)};
+      }
+   } // namespace detail
+
+   MONADS_ABI_END
+} // namespace monad
@@ -0,0 +1,439 @@
+#pragma once
+
+#include "monads/abi.hpp"
+#include "monads/maybe.hpp"
+#include "monads/result.hpp"
+
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+// The coroutines of this header rely on the object returned by get_return_object being converted
+// into the declared return type only once the coroutine has returned to its caller. The point of
+// that conversion is left to the implementation (CWG2563). GCC converts late, which was verified
+// with GCC 12. Clang converts eagerly before version 17, which would read the monad before the
+// coroutine has set it, and is rejected below. Other compilers are not verified, debug builds
+// assert that the monad is set when it is converted.
+#if defined(__clang__) && !defined(__apple_build_version__) && __clang_major__ < 17
+#  error "maybe and result coroutines need Clang 17 or later"
+#elif defined(__apple_build_version__) && __clang_major__ < 16
+#  error "maybe and result coroutines need Apple Clang 16 or later"
+#endif
+
+namespace monad
+{
+   MONADS_ABI_BEGIN
+
+   /**
+    * A caller provided buffer for the frames of maybe and result coroutines. While a scope of the
+    * arena is alive, coroutines started on the same thread take their frame from the arena
+    * instead of the global allocator. Frames are released in the reverse order of their
+    * creation, so the space of a completed call is reused by the next one. Frames that do not fit
+    * fall back to the global allocator
+    */
+   class coroutine_arena
+   {
+      static constexpr std::size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+   public:
+      /**
+       * Installs an arena for the calling thread, restoring the previous one when it ends
+       */
+      class scope
+      {
+      public:
+         explicit scope(coroutine_arena& arena) noexcept :
+            m_previous{std::exchange(current_slot(), &arena)}
+         {}
+         scope(const scope&) = delete;
+         scope(scope&&) = delete;
+         ~scope() { current_slot() = m_previous; }
+
+         auto operator=(const scope&) -> scope& = delete;
+         auto operator=(scope&&) -> scope& = delete;
+
+      private:
+         coroutine_arena* m_previous;
+      };
+
+      explicit coroutine_arena(std::span<std::byte> buffer) noexcept : m_buffer{buffer} {}
+      coroutine_arena(const coroutine_arena&) = delete;
+      coroutine_arena(coroutine_arena&&) = delete;
+      ~coroutine_arena() = default;
+
+      auto operator=(const coroutine_arena&) -> coroutine_arena& = delete;
+      auto operator=(coroutine_arena&&) -> coroutine_arena& = delete;
+
+      /**
+       * The arena installed on the calling thread, if any
+       */
+      static auto current() noexcept -> coroutine_arena* { return current_slot(); }
+
+      auto allocate(std::size_t size) -> void*
+      {
+         const std::size_t first = align(m_used);
+
+         if (first + size > m_buffer.size())
+         {
+            return ::operator new(size);
+         }
+
+         m_used = first + size;
+
+         return m_buffer.data() + first;
+      }
+
+      void deallocate(void* pointer, std::size_t size) noexcept
+      {
+         auto* bytes = static_cast<std::byte*>(pointer);
+
+         if (bytes < m_buffer.data() || bytes >= m_buffer.data() + m_buffer.size())
+         {
+            ::operator delete(pointer, size);
+         }
+         else if (bytes + size == m_buffer.data() + m_used)
+         {
+            m_used = static_cast<std::size_t>(bytes - m_buffer.data());
+         }
+      }
+
+      /**
+       * The number of bytes of the buffer currently in use
+       */
+      [[nodiscard]] auto used() const noexcept -> std::size_t { return m_used; }
+
+   private:
+      static auto current_slot() noexcept -> coroutine_arena*&
+      {
+         thread_local coroutine_arena* arena = nullptr;
+
+         return arena;
+      }
+
+      static constexpr auto align(std::size_t offset) noexcept -> std::size_t
+      {
+         return (offset + alignment - 1) / alignment * alignment;
+      }
+
+   private:
+      std::span<std::byte> m_buffer;
+      std::size_t m_used{0};
+   };
+
+   namespace detail
+   {
+      /**
+       * The object returned by get_return_object. It is converted into the declared monad once
+       * the coroutine has returned to its caller, by which point the coroutine has always run to
+       * completion: maybe and result coroutines never suspend except to stop on a failure. The
+       * late conversion is what GCC and Clang 17 do, see the top of this header
+       */
+      template <class monad_>
+      class coroutine_return
+      {
+      public:
+         template <class promise_>
+         explicit coroutine_return(promise_& promise) noexcept
+         {
+            promise.m_slot = this;
+         }
+         coroutine_return(const coroutine_return&) = delete;
+         coroutine_return(coroutine_return&&) = delete;
+         ~coroutine_return()
+         {
+            if (m_is_set)
+            {
+               std::destroy_at(std::addressof(m_monad));
+            }
+         }
+
+         auto operator=(const coroutine_return&) -> coroutine_return& = delete;
+         auto operator=(coroutine_return&&) -> coroutine_return& = delete;
+
+         template <class... args_>
+         void set(args_&&... args)
+         {
+            std::construct_at(std::addressof(m_monad), std::forward<args_>(args)...);
+            m_is_set = true;
+         }
+
+         operator monad_()
+         {
+            assert(m_is_set);
+
+            return std::move(m_monad);
+         }
+
+      private:
+         union
+         {
+            monad_ m_monad;
+         };
+         bool m_is_set{false};
+      };
+
+      /**
+       * Frame allocation shared by the promises. The frame is followed by a pointer to the arena
+       * it came from, or nullptr if it came from the global allocator
+       */
+      class coroutine_frame
+      {
+         static constexpr std::size_t tail = sizeof(coroutine_arena*);
+
+      public:
+         static auto operator new(std::size_t size) -> void*
+         {
+            return allocate(size, coroutine_arena::current());
+         }
+
+         static void operator delete(void* pointer, std::size_t size) noexcept
+         {
+            coroutine_arena* arena = nullptr;
+            std::memcpy(&arena, static_cast<std::byte*>(pointer) + padded(size), tail);
+
+            if (arena != nullptr)
+            {
+               arena->deallocate(pointer, padded(size) + tail);
+            }
+            else
+            {
+               ::operator delete(pointer, padded(size) + tail);
+            }
+         }
+
+      private:
+         static constexpr auto padded(std::size_t size) noexcept -> std::size_t
+         {
+            return (size + alignof(coroutine_arena*) - 1) / alignof(coroutine_arena*) *
+               alignof(coroutine_arena*);
+         }
+
+         static auto allocate(std::size_t size, coroutine_arena* arena) -> void*
+         {
+            void* pointer = arena != nullptr ? arena->allocate(padded(size) + tail)
+                                             : ::operator new(padded(size) + tail);
+
+            std::memcpy(static_cast<std::byte*>(pointer) + padded(size), &arena, tail);
+
+            return pointer;
+         }
+      };
+
+      /**
+       * Returned by await_transform. A value is handed back to the coroutine without suspending,
+       * a failure is written to the return object and the coroutine is destroyed, which runs the
+       * destructors of its locals and returns control to the caller. The source is held by
+       * reference when source_ is a reference type
+       */
+      template <class source_, class failure_>
+      class coroutine_awaiter
+      {
+      public:
+         constexpr coroutine_awaiter(source_ source, failure_ failure) noexcept :
+            m_source{std::forward<source_>(source)}, m_failure{failure}
+         {}
+
+         [[nodiscard]] constexpr auto await_ready() const noexcept -> bool
+         {
+            return static_cast<bool>(m_source);
+         }
+
+         template <class promise_>
+         void await_suspend(std::coroutine_handle<promise_> handle)
+         {
+            m_failure(handle.promise(), std::forward<source_>(m_source));
+            handle.destroy();
+         }
+
+         constexpr auto await_resume() const noexcept -> decltype(auto)
+         {
+            if constexpr (std::is_rvalue_reference_v<source_>)
+            {
+               return std::move(*m_source);
+            }
+            else
+            {
+               return *m_source;
+            }
+         }
+
+      private:
+         source_ m_source;
+         failure_ m_failure;
+      };
+
+      template <class any_>
+      inline constexpr bool is_maybe = false;
+
+      template <class any_>
+      inline constexpr bool is_maybe<maybe<any_>> = true;
+
+      template <class any_>
+      inline constexpr bool is_result_of = false;
+
+      template <class value_, class error_>
+      inline constexpr bool is_result_of<result<value_, error_>> = true;
+
+      template <class monad_>
+      class coroutine_promise_base : public coroutine_frame
+      {
+         template <class other_>
+         friend class coroutine_return;
+
+      public:
+         constexpr auto get_return_object() noexcept -> coroutine_return<monad_>
+         {
+            return coroutine_return<monad_>{*this};
+         }
+
+         constexpr auto initial_suspend() const noexcept -> std::suspend_never { return {}; }
+         constexpr auto final_suspend() const noexcept -> std::suspend_never { return {}; }
+
+         [[noreturn]] void unhandled_exception() const { throw; }
+
+      protected:
+         template <class... args_>
+         void set(args_&&... args)
+         {
+            m_slot->set(std::forward<args_>(args)...);
+         }
+
+      private:
+         coroutine_return<monad_>* m_slot{nullptr};
+      };
+
+      template <class value_>
+      class maybe_promise : public coroutine_promise_base<maybe<value_>>
+      {
+      public:
+         template <class any_ = value_>
+            requires std::constructible_from<maybe<value_>, any_>
+         void return_value(any_&& value)
+         {
+            this->set(std::forward<any_>(value));
+         }
+
+         /**
+          * co_await on a maybe: an empty maybe makes the coroutine return none
+          */
+         template <class source_>
+            requires is_maybe<std::remove_cvref_t<source_>>
+         auto await_transform(source_&& source) noexcept
+         {
+            constexpr auto fail = [](maybe_promise& promise, auto&&) { promise.set(none); };
+
+            using awaiter = coroutine_awaiter<source_&&, decltype(fail)>;
+
+            return awaiter{std::forward<source_>(source), fail};
+         }
+      };
+
+      template <class value_, class error_>
+      class result_promise_base : public coroutine_promise_base<result<value_, error_>>
+      {
+         template <class source_>
+         struct result_view
+         {
+            source_&& source;
+
+            explicit constexpr operator bool() const noexcept { return source.is_value(); }
+
+            constexpr auto operator*() const noexcept -> decltype(auto)
+            {
+               if constexpr (std::is_void_v<typename std::remove_cvref_t<source_>::value_type>)
+               {
+                  return;
+               }
+               else if constexpr (std::is_lvalue_reference_v<source_>)
+               {
+                  return *source.value_ptr();
+               }
+               else
+               {
+                  return std::move(*source.value_ptr());
+               }
+            }
+         };
+
+      public:
+         /**
+          * co_await on a result: an error, converted to the error type of the coroutine, makes
+          * the coroutine return it
+          */
+         template <class source_>
+            requires is_result_of<std::remove_cvref_t<source_>> &&
+            std::constructible_from<error_, typename std::remove_cvref_t<source_>::error_type>
+         auto await_transform(source_&& source) noexcept
+         {
+            constexpr auto fail = [](result_promise_base& promise, auto&& view) {
+               if constexpr (std::is_lvalue_reference_v<source_>)
+               {
+                  promise.set(std::in_place_index<1>, *view.source.error_ptr());
+               }
+               else
+               {
+                  promise.set(std::in_place_index<1>, std::move(*view.source.error_ptr()));
+               }
+            };
+
+            return coroutine_awaiter<result_view<source_>, decltype(fail)>{
+               result_view<source_>{std::forward<source_>(source)}, fail};
+         }
+      };
+
+      template <class value_, class error_>
+      class result_promise : public result_promise_base<value_, error_>
+      {
+      public:
+         /**
+          * co_return accepts anything a result is built from, such as make_value or make_error,
+          * as well as a plain value
+          */
+         template <class any_ = value_>
+            requires std::constructible_from<result<value_, error_>, any_> ||
+            std::constructible_from<value_, any_>
+         void return_value(any_&& value)
+         {
+            if constexpr (std::constructible_from<result<value_, error_>, any_>)
+            {
+               this->set(std::forward<any_>(value));
+            }
+            else
+            {
+               this->set(std::in_place_index<0>, std::forward<any_>(value));
+            }
+         }
+      };
+
+      template <class error_>
+      class result_promise<void, error_> : public result_promise_base<void, error_>
+      {
+      public:
+         void return_void() { this->set(); }
+      };
+   } // namespace detail
+
+   MONADS_ABI_END
+} // namespace monad
+
+/**
+ * maybe<T> and result<T, E> as coroutine return types
+ */
+template <class value_, class... args_>
+struct std::coroutine_traits<monad::maybe<value_>, args_...>
+{
+   using promise_type = monad::detail::maybe_promise<value_>;
+};
+
+template <class value_, class error_, class... args_>
+struct std::coroutine_traits<monad::result<value_, error_>, args_...>
+{
+   using promise_type = monad::detail::result_promise<value_, error_>;
+};
@@ -1,9 +1,12 @@
 #pragma once
 
+#include "monads/abi.hpp"
 #include "monads/maybe.hpp"
 
 namespace monad
 {
+   MONADS_ABI_BEGIN
+
    // clang-format off
    template <class left_, class right_>
       requires (!(std::is_reference_v<left_> || std::is_reference_v<right_>))
@@ -44,6 +47,20 @@ namespace monad
       {
          return e;
       }
+
+      // clang-format off
+      /**
+       * Payloads a sum type can assign without losing its current content when the copy throws:
+       * each one is copied in place if that cannot throw, or into a temporary then moved in
+       * without throwing
+       */
+      template <class... types_>
+      concept copy_replaceable = ((std::is_nothrow_copy_constructible_v<types_> ||
+                                   std::is_nothrow_move_constructible_v<types_>) && ...);
+
+      template <class... types_>
+      concept move_replaceable = (std::is_nothrow_move_constructible_v<types_> && ...);
+      // clang-format on
    } // namespace detail
 
    template <class any_>
@@ -76,7 +93,7 @@ namespace monad
    class either
    // clang-format on
    {
-      template <class first_, class second_, class dummy_ = void>
+      template <class first_, class second_>
       class storage
       {
       public:
@@ -84,33 +101,25 @@ namespace monad
          using right_type = second_;
 
       private:
-         using storage_type =
-            std::array<std::byte, detail::max(sizeof(left_type), sizeof(right_type))>;
-
          // clang-format off
          static inline constexpr bool is_nothrow_default_constructible =
-            std::is_nothrow_default_constructible_v<left_type> && 
-            std::is_nothrow_default_constructible_v<storage_type>;
+            std::is_nothrow_default_constructible_v<left_type>;
 
          static inline constexpr bool is_nothrow_copy_left_constructible =
             std::is_nothrow_copy_assignable_v<left_type> &&
-            std::is_nothrow_copy_constructible_v<left_type> && 
-            std::is_nothrow_default_constructible_v<storage_type>;
+            std::is_nothrow_copy_constructible_v<left_type>;
 
          static inline constexpr bool is_nothrow_move_left_constructible =
             std::is_nothrow_move_assignable_v<left_type> &&
-            std::is_nothrow_move_constructible_v<left_type> &&
-            std::is_nothrow_default_constructible_v<storage_type>;
+            std::is_nothrow_move_constructible_v<left_type>;
 
          static inline constexpr bool is_nothrow_copy_right_constructible =
             std::is_nothrow_copy_assignable_v<right_type> &&
-            std::is_nothrow_copy_constructible_v<right_type> && 
-            std::is_nothrow_default_constructible_v<storage_type>;
+            std::is_nothrow_copy_constructible_v<right_type>;
 
          static inline constexpr bool is_nothrow_move_right_constructible = 
             std::is_nothrow_move_assignable_v<right_type> &&
-            std::is_nothrow_move_constructible_v<right_type> &&
-            std::is_nothrow_default_constructible_v<storage_type>;
+            std::is_nothrow_move_constructible_v<right_type>;
 
          static inline constexpr bool is_nothrow_copy_constructible =
             is_nothrow_copy_left_constructible && 
@@ -122,8 +131,7 @@ namespace monad
 
          static inline constexpr bool is_nothrow_destructible = 
             std::is_nothrow_destructible_v<left_type> &&
-            std::is_nothrow_destructible_v<right_type> &&
-            std::is_nothrow_destructible_v<storage_type>;
+            std::is_nothrow_destructible_v<right_type>;
 
          static inline constexpr bool is_nothrow_copy_assignable =
             is_nothrow_copy_constructible &&
@@ -148,120 +156,134 @@ namespace monad
          static inline constexpr bool is_nothrow_right_value_movable =
             std::is_nothrow_move_assignable_v<right_type> &&
             std::is_nothrow_move_constructible_v<right_type>;
+
+         static inline constexpr bool is_trivially_copy_constructible =
+            trivially_copy_constructible<left_type> &&
+            trivially_copy_constructible<right_type>;
+
+         static inline constexpr bool is_trivially_move_constructible =
+            trivially_move_constructible<left_type> &&
+            trivially_move_constructible<right_type>;
+
+         static inline constexpr bool is_trivially_destructible =
+            trivially_destructible<left_type> &&
+            trivially_destructible<right_type>;
+
+         static inline constexpr bool is_trivially_copy_assignable =
+            trivially_copy_assignable<left_type> &&
+            trivially_copy_assignable<right_type>;
+
+         static inline constexpr bool is_trivially_move_assignable =
+            trivially_move_assignable<left_type> &&
+            trivially_move_assignable<right_type>;
          // clang-format on
 
       public:
-         constexpr storage() noexcept(is_nothrow_default_constructible)
-         {
-            std::construct_at(std::addressof(left()), left_type{});
-         };
-         constexpr storage(const left_t<left_type>& l) noexcept(is_nothrow_copy_left_constructible)
-         {
-            std::construct_at(std::addressof(left()), l.value);
-         }
-         constexpr storage(left_t<left_type>&& l) noexcept(is_nothrow_move_left_constructible)
-         {
-            std::construct_at(std::addressof(left()), std::move(l.value));
-         }
+         constexpr storage() noexcept(is_nothrow_default_constructible) :
+            m_left()
+         {}
+         constexpr storage(const left_t<left_type>& l) noexcept(
+            is_nothrow_copy_left_constructible) :
+            m_left(l.value)
+         {}
+         constexpr storage(left_t<left_type>&& l) noexcept(is_nothrow_move_left_constructible) :
+            m_left(std::move(l.value))
+         {}
          constexpr storage(const right_t<right_type>& r) noexcept(
             is_nothrow_copy_right_constructible) :
+            m_right(r.value),
             m_is_right{true}
-         {
-            std::construct_at(std::addressof(right()), r.value);
-         }
+         {}
          constexpr storage(right_t<right_type>&& r) noexcept(is_nothrow_move_right_constructible) :
+            m_right(std::move(r.value)),
             m_is_right{true}
-         {
-            std::construct_at(std::addressof(right()), std::move(r.value));
-         }
+         {}
+         constexpr storage(std::in_place_index_t<0>, auto&&... args) noexcept(
+            std::is_nothrow_constructible_v<left_type, decltype(args)...>) :
+            m_left(std::forward<decltype(args)>(args)...)
+         {}
+         constexpr storage(std::in_place_index_t<1>, auto&&... args) noexcept(
+            std::is_nothrow_constructible_v<right_type, decltype(args)...>) :
+            m_right(std::forward<decltype(args)>(args)...),
+            m_is_right{true}
+         {}
+         constexpr storage(detail::from_invoke_t<0>, auto&& fun, auto&&... args) :
+            m_left(std::invoke(std::forward<decltype(fun)>(fun),
+                                std::forward<decltype(args)>(args)...))
+         {}
+         constexpr storage(detail::from_invoke_t<1>, auto&& fun, auto&&... args) :
+            m_right(std::invoke(std::forward<decltype(fun)>(fun),
+                                 std::forward<decltype(args)>(args)...)),
+            m_is_right{true}
+         {}
+         constexpr storage(const storage&) requires is_trivially_copy_constructible = default;
          constexpr storage(const storage& rhs) noexcept(is_nothrow_copy_constructible) :
             m_is_right{rhs.is_right()}
          {
-            if (!is_right())
-            {
-               std::construct_at(std::addressof(left()), rhs.left());
-            }
-            else
-            {
-               std::construct_at(std::addressof(right()()), rhs.right());
-            }
+            construct_from(rhs);
          }
+         constexpr storage(storage&&) requires is_trivially_move_constructible = default;
          constexpr storage(storage&& rhs) noexcept(is_nothrow_move_constructible) :
             m_is_right{rhs.is_right()}
          {
-            if (!is_right())
-            {
-               std::construct_at(std::addressof(left()), std::move(rhs.left()));
-            }
-            else
-            {
-               std::construct_at(std::addressof(right()), std::move(rhs.right()));
-            }
-
-            rhs.m_is_right = false;
+            construct_from(std::move(rhs));
          }
-         ~storage() noexcept(is_nothrow_destructible)
+         constexpr storage(std::allocator_arg_t, const auto& allocator, const storage& rhs) :
+            m_is_right{rhs.is_right()}
          {
-            if (!is_right())
-            {
-               std::destroy_at(std::addressof(left()));
-            }
-            else
-            {
-               std::destroy_at(std::addressof(right()));
-            }
+            construct_from(allocator, rhs);
          }
+         constexpr storage(std::allocator_arg_t, const auto& allocator, storage&& rhs) :
+            m_is_right{rhs.is_right()}
+         {
+            construct_from(allocator, std::move(rhs));
+         }
+         ~storage() requires is_trivially_destructible = default;
+         constexpr ~storage() noexcept(is_nothrow_destructible) { destroy(); }
 
-         constexpr auto operator=(const storage& rhs) -> storage&
+         constexpr auto operator=(const storage&) -> storage& requires
+            detail::copy_replaceable<left_type, right_type> && is_trivially_copy_assignable =
+               default;
+         /**
+          * Copy the content of rhs through emplace, so that a copy which throws leaves the current
+          * content untouched
+          */
+         constexpr auto operator=(const storage& rhs) noexcept(is_nothrow_copy_assignable)
+            -> storage& requires detail::copy_replaceable<left_type, right_type>
          {
             if (this != &rhs)
             {
-               if (!is_right())
-               {
-                  std::destroy_at(std::addressof(left()));
-               }
-               else
+               if (rhs.is_right())
                {
-                  std::destroy_at(std::addressof(right()));
-               }
-
-               m_is_right = rhs.is_right();
-
-               if (!is_right())
-               {
-                  std::construct_at(std::addressof(left()), rhs.left());
+                  emplace_right(rhs.right());
                }
                else
                {
-                  std::construct_at(std::addressof(right()), rhs.right());
+                  emplace_left(rhs.left());
                }
             }
 
             return *this;
          }
-         constexpr auto operator=(storage&& rhs) noexcept(is_nothrow_move_assignable) -> storage&
+         constexpr auto operator=(storage&&) -> storage& requires
+            detail::move_replaceable<left_type, right_type> && is_trivially_move_assignable =
+               default;
+         /**
+          * Move the content of rhs in through emplace, both payloads must be nothrow move
+          * constructible. Payloads whose move may throw are assigned through the copy assignment
+          */
+         constexpr auto operator=(storage&& rhs) noexcept(is_nothrow_move_assignable)
+            -> storage& requires detail::move_replaceable<left_type, right_type>
          {
             if (this != &rhs)
             {
-               if (!is_right())
+               if (rhs.is_right())
                {
-                  std::destroy_at(std::addressof(left()));
+                  emplace_right(std::move(rhs.right()));
                }
                else
                {
-                  std::destroy_at(std::addressof(right()));
-               }
-
-               m_is_right = rhs.is_right();
-               rhs.m_is_right = false;
-
-               if (!is_right())
-               {
-                  std::construct_at(std::addressof(left()), rhs.left());
-               }
-               else
-               {
-                  std::construct_at(std::addressof(right()), rhs.right());
+                  emplace_left(std::move(rhs.left()));
                }
             }
 
@@ -300,99 +322,123 @@ namespace monad
             return std::move(*r_pointer());
          }
 
-      private:
-         constexpr auto l_pointer() noexcept -> left_type*
+         constexpr auto emplace_left(auto&&... args) -> left_type&
          {
-            return reinterpret_cast<left_type*>(m_bytes.data()); // NOLINT
-         }
-         constexpr auto l_pointer() const noexcept -> const left_type*
-         {
-            return reinterpret_cast<const left_type*>(m_bytes.data()); // NOLINT
-         }
+            if constexpr (std::is_nothrow_constructible_v<left_type, decltype(args)...>)
+            {
+               destroy();
+               std::construct_at(l_pointer(), std::forward<decltype(args)>(args)...);
+            }
+            else
+            {
+               left_type temporary(std::forward<decltype(args)>(args)...);
 
-         constexpr auto r_pointer() noexcept -> right_type*
-         {
-            return reinterpret_cast<right_type*>(m_bytes.data()); // NOLINT
+               destroy();
+               std::construct_at(l_pointer(), std::move(temporary));
+            }
+
+            m_is_right = false;
+
+            return *l_pointer();
          }
-         constexpr auto r_pointer() const noexcept -> const right_type*
+         constexpr auto emplace_right(auto&&... args) -> right_type&
          {
-            return reinterpret_cast<const right_type*>(m_bytes.data()); // NOLINT
-         }
-
-      private:
-         alignas(detail::max(alignof(left_type), alignof(right_type))) storage_type m_bytes{};
-         bool m_is_right{false};
-      };
+            if constexpr (std::is_nothrow_constructible_v<right_type, decltype(args)...>)
+            {
+               destroy();
+               std::construct_at(r_pointer(), std::forward<decltype(args)>(args)...);
+            }
+            else
+            {
+               right_type temporary(std::forward<decltype(args)>(args)...);
 
-      template <class first_, class second_>
-      class storage<first_, second_, std::enable_if_t<trivial<first_> && trivial<second_>>>
-      {
-      public:
-         using left_type = first_;
-         using right_type = second_;
+               destroy();
+               std::construct_at(r_pointer(), std::move(temporary));
+            }
 
-      private:
-         using storage_type =
-            std::array<std::byte, detail::max(sizeof(left_type), sizeof(right_type))>;
+            m_is_right = true;
 
-      public:
-         constexpr storage() noexcept { std::construct_at(std::addressof(left()), left_type{}); };
-         constexpr storage(const left_t<left_type>& l) noexcept
-         {
-            std::construct_at(std::addressof(left()), l.value);
+            return *r_pointer();
          }
-         constexpr storage(left_t<left_type>&& l) noexcept
+
+      private:
+         constexpr void construct_from(const storage& rhs)
          {
-            std::construct_at(std::addressof(left()), std::move(l.value));
+            if (!is_right())
+            {
+               std::construct_at(l_pointer(), rhs.left());
+            }
+            else
+            {
+               std::construct_at(r_pointer(), rhs.right());
+            }
          }
-         constexpr storage(const right_t<right_type>& r) noexcept : m_is_right{true}
+         constexpr void construct_from(storage&& rhs)
          {
-            std::construct_at(std::addressof(right()), r.value);
+            if (!is_right())
+            {
+               std::construct_at(l_pointer(), std::move(rhs.left()));
+            }
+            else
+            {
+               std::construct_at(r_pointer(), std::move(rhs.right()));
+            }
          }
-         constexpr storage(right_t<right_type>&& r) noexcept : m_is_right{true}
+         constexpr void construct_from(const auto& allocator, const storage& rhs)
          {
-            std::construct_at(std::addressof(right()), std::move(r.value));
+            if (!is_right())
+            {
+               std::uninitialized_construct_using_allocator(l_pointer(), allocator, rhs.left());
+            }
+            else
+            {
+               std::uninitialized_construct_using_allocator(r_pointer(), allocator, rhs.right());
+            }
          }
-
-         constexpr auto left() & noexcept -> left_type& { return *l_pointer(); }
-         constexpr auto left() const& noexcept -> const left_type& { return *l_pointer(); }
-         constexpr auto left() && noexcept -> left_type&& { return std::move(*l_pointer()); }
-         constexpr auto left() const&& noexcept -> const left_type&&
+         constexpr void construct_from(const auto& allocator, storage&& rhs)
          {
-            return std::move(*l_pointer());
+            if (!is_right())
+            {
+               std::uninitialized_construct_using_allocator(l_pointer(), allocator,
+                                                            std::move(rhs.left()));
+            }
+            else
+            {
+               std::uninitialized_construct_using_allocator(r_pointer(), allocator,
+                                                            std::move(rhs.right()));
+            }
          }
 
-         constexpr auto right() & noexcept -> right_type& { return *r_pointer(); }
-         constexpr auto right() const& noexcept -> const right_type& { return *r_pointer(); }
-         constexpr auto right() && noexcept -> right_type&& { return std::move(*r_pointer()); }
-         constexpr auto right() const&& noexcept -> const right_type&&
+         constexpr void destroy() noexcept(is_nothrow_destructible)
          {
-            return std::move(*r_pointer());
+            if (!is_right())
+            {
+               std::destroy_at(l_pointer());
+            }
+            else
+            {
+               std::destroy_at(r_pointer());
+            }
          }
 
-         [[nodiscard]] constexpr auto is_right() const noexcept -> bool { return m_is_right; };
-
-      private:
-         constexpr auto l_pointer() noexcept -> left_type*
-         {
-            return reinterpret_cast<left_type*>(m_bytes.data()); // NOLINT
-         }
+         constexpr auto l_pointer() noexcept -> left_type* { return std::addressof(m_left); }
          constexpr auto l_pointer() const noexcept -> const left_type*
          {
-            return reinterpret_cast<const left_type*>(m_bytes.data()); // NOLINT
+            return std::addressof(m_left);
          }
 
-         constexpr auto r_pointer() noexcept -> right_type*
-         {
-            return reinterpret_cast<right_type*>(m_bytes.data()); // NOLINT
-         }
+         constexpr auto r_pointer() noexcept -> right_type* { return std::addressof(m_right); }
          constexpr auto r_pointer() const noexcept -> const right_type*
          {
-            return reinterpret_cast<const right_type*>(m_bytes.data()); // NOLINT
+            return std::addressof(m_right);
          }
 
       private:
-         alignas(detail::max(alignof(left_type), alignof(right_type))) storage_type m_bytes{};
+         union
+         {
+            left_type m_left;
+            right_type m_right;
+         };
          bool m_is_right{false};
       };
 
@@ -437,54 +483,183 @@ namespace monad
       {}
       constexpr either(const right_t<right_type>& right) : m_storage{right} {}
       constexpr either(right_t<right_type>&& right) : m_storage{std::move(right)} {}
+      /**
+       * Construct the left in place from the arguments, without an intermediate left_t
+       */
+      constexpr either(std::in_place_index_t<0> tag, auto&&... args) noexcept(
+         std::is_nothrow_constructible_v<left_type, decltype(args)...>)
+         requires std::constructible_from<left_type, decltype(args)...> :
+         m_storage{tag, std::forward<decltype(args)>(args)...}
+      {}
+      /**
+       * Construct the left in place from the arguments, without an intermediate left_t
+       */
+      constexpr either(std::in_place_type_t<left_type>, auto&&... args) noexcept(
+         std::is_nothrow_constructible_v<left_type, decltype(args)...>)
+         requires(!std::is_same_v<left_type, right_type>) &&
+         std::constructible_from<left_type, decltype(args)...> :
+         m_storage{std::in_place_index<0>, std::forward<decltype(args)>(args)...}
+      {}
+      /**
+       * Construct the right in place from the arguments, without an intermediate right_t
+       */
+      constexpr either(std::in_place_index_t<1> tag, auto&&... args) noexcept(
+         std::is_nothrow_constructible_v<right_type, decltype(args)...>)
+         requires std::constructible_from<right_type, decltype(args)...> :
+         m_storage{tag, std::forward<decltype(args)>(args)...}
+      {}
+      /**
+       * Construct the right in place from the arguments, without an intermediate right_t
+       */
+      constexpr either(std::in_place_type_t<right_type>, auto&&... args) noexcept(
+         std::is_nothrow_constructible_v<right_type, decltype(args)...>)
+         requires(!std::is_same_v<left_type, right_type>) &&
+         std::constructible_from<right_type, decltype(args)...> :
+         m_storage{std::in_place_index<1>, std::forward<decltype(args)>(args)...}
+      {}
+
+      /**
+       * Allocator-extended constructors, the payload is built with uses-allocator construction
+       */
+      constexpr either(std::allocator_arg_t, const auto& allocator, const left_t<left_type>& left) :
+         m_storage{detail::from_invoke<0>, detail::construct_using_allocator<left_type>, allocator,
+                   left.value}
+      {}
+      constexpr either(std::allocator_arg_t, const auto& allocator, left_t<left_type>&& left) :
+         m_storage{detail::from_invoke<0>, detail::construct_using_allocator<left_type>, allocator,
+                   std::move(left.value)}
+      {}
+      constexpr either(std::allocator_arg_t, const auto& allocator,
+                       const right_t<right_type>& right) :
+         m_storage{detail::from_invoke<1>, detail::construct_using_allocator<right_type>, allocator,
+                   right.value}
+      {}
+      constexpr either(std::allocator_arg_t, const auto& allocator, right_t<right_type>&& right) :
+         m_storage{detail::from_invoke<1>, detail::construct_using_allocator<right_type>, allocator,
+                   std::move(right.value)}
+      {}
+      constexpr either(std::allocator_arg_t, const auto& allocator, std::in_place_index_t<0>,
+                       auto&&... args)
+         requires std::constructible_from<left_type, decltype(args)...> :
+         m_storage{detail::from_invoke<0>, detail::construct_using_allocator<left_type>, allocator,
+                   std::forward<decltype(args)>(args)...}
+      {}
+      constexpr either(std::allocator_arg_t, const auto& allocator, std::in_place_index_t<1>,
+                       auto&&... args)
+         requires std::constructible_from<right_type, decltype(args)...> :
+         m_storage{detail::from_invoke<1>, detail::construct_using_allocator<right_type>, allocator,
+                   std::forward<decltype(args)>(args)...}
+      {}
+      constexpr either(std::allocator_arg_t tag, const auto& allocator, const either& other) :
+         m_storage{tag, allocator, other.m_storage}
+      {}
+      constexpr either(std::allocator_arg_t tag, const auto& allocator, either&& other) :
+         m_storage{tag, allocator, std::move(other.m_storage)}
+      {}
 
       [[nodiscard]] constexpr auto is_right() const -> bool { return m_storage.is_right(); }
       constexpr operator bool() const { return is_right(); }
 
-      constexpr auto left() const& -> maybe<left_type> requires copyable
+      constexpr auto left() const& -> maybe<left_type> requires std::copyable<left_type>
       {
-         return !is_right() ? make_maybe(m_storage.left()) : none;
+         return !is_right() ? make_maybe(detail::keep_allocator(m_storage.left())) : none;
       }
-      constexpr auto left() & -> maybe<left_type> requires copyable
+      constexpr auto left() & -> maybe<left_type> requires std::copyable<left_type>
       {
-         return !is_right() ? make_maybe(m_storage.left()) : none;
+         return !is_right() ? make_maybe(detail::keep_allocator(m_storage.left())) : none;
       }
-      constexpr auto left() const&& -> maybe<left_type> requires movable
+      constexpr auto left() const&& -> maybe<left_type> requires std::movable<left_type>
       {
          return !is_right() ? make_maybe(std::move(m_storage.left())) : none;
       }
-      constexpr auto left() && -> maybe<left_type> requires movable
+      constexpr auto left() && -> maybe<left_type> requires std::movable<left_type>
       {
          return !is_right() ? make_maybe(std::move(m_storage.left())) : none;
       }
 
-      constexpr auto right() const& -> maybe<right_type> requires copyable
+      constexpr auto right() const& -> maybe<right_type> requires std::copyable<right_type>
       {
-         return !is_right() ? none : make_maybe(m_storage.right());
+         return !is_right() ? none : make_maybe(detail::keep_allocator(m_storage.right()));
       }
-      constexpr auto right() & -> maybe<right_type> requires copyable
+      constexpr auto right() & -> maybe<right_type> requires std::copyable<right_type>
       {
-         return !is_right() ? none : make_maybe(m_storage.right());
+         return !is_right() ? none : make_maybe(detail::keep_allocator(m_storage.right()));
       }
-      constexpr auto right() const&& -> maybe<right_type> requires movable
+      constexpr auto right() const&& -> maybe<right_type> requires std::movable<right_type>
       {
          return !is_right() ? none : make_maybe(std::move(m_storage.right()));
       }
-      constexpr auto right() && -> maybe<right_type> requires movable
+      constexpr auto right() && -> maybe<right_type> requires std::movable<right_type>
       {
          return !is_right() ? none : make_maybe(std::move(m_storage.right()));
       }
 
+      /**
+       * Access the stored left value without copying it, returns nullptr if a right value is stored
+       */
+      constexpr auto left_ptr() noexcept -> left_type*
+      {
+         return !is_right() ? std::addressof(m_storage.left()) : nullptr;
+      }
+      /**
+       * Access the stored left value without copying it, returns nullptr if a right value is stored
+       */
+      constexpr auto left_ptr() const noexcept -> const left_type*
+      {
+         return !is_right() ? std::addressof(m_storage.left()) : nullptr;
+      }
+
+      /**
+       * Access the stored right value without copying it, returns nullptr if a left value is stored
+       */
+      constexpr auto right_ptr() noexcept -> right_type*
+      {
+         return !is_right() ? nullptr : std::addressof(m_storage.right());
+      }
+      /**
+       * Access the stored right value without copying it, returns nullptr if a left value is stored
+       */
+      constexpr auto right_ptr() const noexcept -> const right_type*
+      {
+         return !is_right() ? nullptr : std::addressof(m_storage.right());
+      }
+
+      /**
+       * Destroy the current content and construct the left in place from the arguments. If the
+       * construction may throw, the left is built first and moved in, which must not throw, so
+       * that the current content survives a failed construction
+       */
+      constexpr auto emplace_left(auto&&... args) -> left_type& requires
+         std::constructible_from<left_type, decltype(args)...> &&
+         (std::is_nothrow_constructible_v<left_type, decltype(args)...> ||
+          std::is_nothrow_move_constructible_v<left_type>)
+      {
+         return m_storage.emplace_left(std::forward<decltype(args)>(args)...);
+      }
+
+      /**
+       * Destroy the current content and construct the right in place from the arguments. If the
+       * construction may throw, the right is built first and moved in, which must not throw, so
+       * that the current content survives a failed construction
+       */
+      constexpr auto emplace_right(auto&&... args) -> right_type& requires
+         std::constructible_from<right_type, decltype(args)...> &&
+         (std::is_nothrow_constructible_v<right_type, decltype(args)...> ||
+          std::is_nothrow_move_constructible_v<right_type>)
+      {
+         return m_storage.emplace_right(std::forward<decltype(args)>(args)...);
+      }
+
       constexpr auto
       left_map(const std::invocable<left_type> auto& fun) const& -> left_map_either<decltype(fun)>
       {
          if (!is_right())
          {
-            return make_left(std::invoke(fun, m_storage.left()));
+            return {detail::from_invoke<0>, fun, m_storage.left()};
          }
          else
          {
-            return make_right(m_storage.right());
+            return {std::in_place_index<1>, detail::keep_allocator(m_storage.right())};
          }
       }
       constexpr auto
@@ -492,11 +667,11 @@ namespace monad
       {
          if (!is_right())
          {
-            return make_left(std::invoke(fun, m_storage.left()));
+            return {detail::from_invoke<0>, fun, m_storage.left()};
          }
          else
          {
-            return make_right(m_storage.right());
+            return {std::in_place_index<1>, detail::keep_allocator(m_storage.right())};
          }
       }
       constexpr auto
@@ -504,11 +679,11 @@ namespace monad
       {
          if (!is_right())
          {
-            return make_left(std::invoke(fun, std::move(m_storage.left())));
+            return {detail::from_invoke<0>, fun, std::move(m_storage.left())};
          }
          else
          {
-            return make_right(std::move(m_storage.right()));
+            return {std::in_place_index<1>, std::move(m_storage.right())};
          }
       }
       constexpr auto
@@ -516,11 +691,11 @@ namespace monad
       {
          if (!is_right())
          {
-            return make_left(std::invoke(fun, std::move(m_storage.left())));
+            return {detail::from_invoke<0>, fun, std::move(m_storage.left())};
          }
          else
          {
-            return make_right(std::move(m_storage.right()));
+            return {std::in_place_index<1>, std::move(m_storage.right())};
          }
       }
 
@@ -529,11 +704,11 @@ namespace monad
       {
          if (!is_right())
          {
-            return make_left(m_storage.left());
+            return {std::in_place_index<0>, detail::keep_allocator(m_storage.left())};
          }
          else
          {
-            return make_right(std::invoke(fun, m_storage.right()));
+            return {detail::from_invoke<1>, fun, m_storage.right()};
          }
       }
       constexpr auto
@@ -541,11 +716,11 @@ namespace monad
       {
          if (!is_right())
          {
-            return make_left(m_storage.left());
+            return {std::in_place_index<0>, detail::keep_allocator(m_storage.left())};
          }
          else
          {
-            return make_right(std::invoke(fun, m_storage.right()));
+            return {detail::from_invoke<1>, fun, m_storage.right()};
          }
       }
       constexpr auto right_map(
@@ -553,11 +728,11 @@ namespace monad
       {
          if (!is_right())
          {
-            return make_left(std::move(m_storage.left()));
+            return {std::in_place_index<0>, std::move(m_storage.left())};
          }
          else
          {
-            return make_right(std::invoke(fun, std::move(m_storage.right())));
+            return {detail::from_invoke<1>, fun, std::move(m_storage.right())};
          }
       }
       constexpr auto
@@ -565,11 +740,11 @@ namespace monad
       {
          if (!is_right())
          {
-            return make_left(std::move(m_storage.left()));
+            return {std::in_place_index<0>, std::move(m_storage.left())};
          }
          else
          {
-            return make_right(std::invoke(fun, std::move(m_storage.right())));
+            return {detail::from_invoke<1>, fun, std::move(m_storage.right())};
          }
       }
 
@@ -627,9 +802,21 @@ namespace monad
                             : std::invoke(r_fun, std::move(m_storage.right()));
       }
 
+   private:
+      template <std::size_t index_>
+      constexpr either(detail::from_invoke_t<index_> tag, auto&& fun, auto&&... args) :
+         m_storage{tag, std::forward<decltype(fun)>(fun), std::forward<decltype(args)>(args)...}
+      {}
+
    private:
       storage<left_type, right_type> m_storage{};
 
+      // clang-format off
+      template <class other_left_, class other_right_>
+         requires (!(std::is_reference_v<other_left_> || std::is_reference_v<other_right_>))
+      friend class either;
+      // clang-format on
+
    public:
       constexpr auto left_flat_map(const std::invocable<left_type> auto& fun) const& -> decltype(
          detail::ensure_either_right(std::invoke(fun, m_storage.left()), m_storage.right()))
@@ -640,7 +827,7 @@ namespace monad
          }
          else
          {
-            return make_right(m_storage.right());
+            return {std::in_place_index<1>, detail::keep_allocator(m_storage.right())};
          }
       }
       constexpr auto left_flat_map(const std::invocable<left_type> auto& fun) & -> decltype(
@@ -652,7 +839,7 @@ namespace monad
          }
          else
          {
-            return make_right(m_storage.right());
+            return {std::in_place_index<1>, detail::keep_allocator(m_storage.right())};
          }
       }
       constexpr auto left_flat_map(const std::invocable<left_type> auto& fun) const&& -> decltype(
@@ -665,7 +852,7 @@ namespace monad
          }
          else
          {
-            return make_right(std::move(m_storage.right()));
+            return {std::in_place_index<1>, std::move(m_storage.right())};
          }
       }
       constexpr auto left_flat_map(const std::invocable<left_type> auto& fun) && -> decltype(
@@ -678,7 +865,7 @@ namespace monad
          }
          else
          {
-            return make_right(std::move(m_storage.right()));
+            return {std::in_place_index<1>, std::move(m_storage.right())};
          }
       }
 
@@ -687,7 +874,7 @@ namespace monad
       {
          if (!is_right())
          {
-            return make_left(m_storage.left());
+            return {std::in_place_index<0>, detail::keep_allocator(m_storage.left())};
          }
          else
          {
@@ -699,7 +886,7 @@ namespace monad
       {
          if (!is_right())
          {
-            return make_left(m_storage.left());
+            return {std::in_place_index<0>, detail::keep_allocator(m_storage.left())};
          }
          else
          {
@@ -712,7 +899,7 @@ namespace monad
       {
          if (!is_right())
          {
-            return make_left(std::move(m_storage.left()));
+            return {std::in_place_index<0>, std::move(m_storage.left())};
          }
          else
          {
@@ -725,7 +912,7 @@ namespace monad
       {
          if (!is_right())
          {
-            return make_left(std::move(m_storage.left()));
+            return {std::in_place_index<0>, std::move(m_storage.left())};
          }
          else
          {
@@ -733,4 +920,15 @@ namespace monad
          }
       }
    };
+
+   MONADS_ABI_END
 } // namespace monad
+
+namespace std // NOLINT
+{
+   template <class left_, class right_, class allocator_>
+   struct uses_allocator<monad::either<left_, right_>, allocator_> :
+      bool_constant<uses_allocator_v<left_, allocator_> || uses_allocator_v<right_, allocator_>>
+   {
+   };
+} // namespace std
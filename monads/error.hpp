@@ -0,0 +1,426 @@
+#pragma once
+
+#include <monads/abi.hpp>
+#include <monads/result.hpp>
+#include <monads/try.hpp>
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+
+namespace monad
+{
+   MONADS_ABI_BEGIN
+
+   /**
+    * Customization point describing the codes of an enumeration used as monad::error codes.
+    * Specializations provide
+    *
+    *    static constexpr std::uint16_t id;
+    *    static constexpr std::string_view name;
+    *    static constexpr std::array<std::string_view, N> messages;
+    *
+    * where id is unique in the program, between 1 and error_category_capacity - 1, and messages
+    * holds the message of each code, indexed by the value of the code. Two categories with the
+    * same id trip an assertion when the second one is registered. A message may contain {}
+    * placeholders, replaced in order by the arguments of the error when it is rendered, for
+    * instance
+    *
+    *    template <>
+    *    struct monad::error_category<parse_code>
+    *    {
+    *       static constexpr std::uint16_t id = 1;
+    *       static constexpr std::string_view name = "parse";
+    *       static constexpr std::array<std::string_view, 2> messages{
+    *          "unexpected character {} at offset {}", "number out of range: {}"};
+    *    };
+    */
+   template <class code_>
+   struct error_category
+   {
+   };
+
+   /**
+    * Number of categories a program may register, id 0 is the category of std::errc
+    */
+   inline constexpr std::uint16_t error_category_capacity = 256;
+
+   // clang-format off
+   template <class any_>
+   concept error_code_enum = std::is_enum_v<any_> && requires
+   {
+      { error_category<any_>::id } -> std::convertible_to<std::uint16_t>;
+      { error_category<any_>::name } -> std::convertible_to<std::string_view>;
+      { error_category<any_>::messages[std::size_t{}] } -> std::convertible_to<std::string_view>;
+      { error_category<any_>::messages.size() } -> std::convertible_to<std::size_t>;
+   };
+
+   /**
+    * The arguments an error captures by value. Character pointers are captured as pointers and
+    * must outlive the error, as string literals do
+    */
+   template <class any_>
+   concept error_argument = std::is_arithmetic_v<any_> || std::same_as<any_, std::errc> ||
+      std::same_as<any_, const char*>;
+   // clang-format on
+
+   namespace detail
+   {
+      struct error_category_info
+      {
+         std::string_view name;
+         auto (*message)(std::uint16_t code) noexcept -> std::string_view;
+      };
+
+      template <class code_>
+      constexpr auto category_message(std::uint16_t code) noexcept -> std::string_view
+      {
+         const auto& messages = error_category<code_>::messages;
+
+         return code < messages.size() ? std::string_view{messages[code]} : std::string_view{};
+      }
+
+      template <class code_>
+      inline constexpr error_category_info category_info{error_category<code_>::name,
+                                                         &category_message<code_>};
+
+      inline constexpr error_category_info generic_category_info{
+         "generic", [](std::uint16_t) noexcept -> std::string_view { return "{}"; }};
+
+      /**
+       * The categories of the program, indexed by id. The table is constant initialized and each
+       * category is stored in its slot by the errors built with it at runtime, so that it is
+       * there before any of its errors is rendered, whatever the order of static initialization
+       */
+      inline std::array<std::atomic<const error_category_info*>, error_category_capacity>
+         error_categories{&generic_category_info};
+
+      template <class code_>
+      void store_error_category() noexcept
+      {
+         constexpr const error_category_info* info = &category_info<code_>;
+
+         auto& slot = error_categories[error_category<code_>::id];
+         const auto* stored = slot.load(std::memory_order_relaxed);
+
+         if (stored != info)
+         {
+            assert(stored == nullptr && "two error categories have the same id");
+
+            slot.store(info, std::memory_order_release);
+         }
+      }
+
+      /**
+       * Errors built in constant evaluation cannot store their category, it is stored during
+       * dynamic initialization instead
+       */
+      template <class code_>
+      struct error_category_registration
+      {
+         static inline const bool registered = (store_error_category<code_>(), true);
+      };
+
+      template <class code_>
+      constexpr void register_error_category() noexcept
+      {
+         static_assert(error_category<code_>::id > 0 &&
+                          error_category<code_>::id < error_category_capacity,
+                       "error category ids are between 1 and error_category_capacity - 1");
+
+         if (std::is_constant_evaluated())
+         {
+            static_cast<void>(&error_category_registration<code_>::registered);
+         }
+         else
+         {
+            store_error_category<code_>();
+         }
+      }
+   } // namespace detail
+
+   /**
+    * An error as cheap to return as an integer: a 32 bit id made of the category of the error and
+    * its code, and up to max_arguments arguments captured by value. Nothing is formatted or
+    * allocated until message() is called. An error is trivially copyable, and its ids compare
+    * equal regardless of the arguments
+    */
+   class error
+   {
+   public:
+      static constexpr std::size_t max_arguments = 2;
+
+      /**
+       * An error of the category of the code, capturing the arguments of its message
+       */
+      template <error_code_enum code_, class... arguments_>
+         requires(sizeof...(arguments_) <= max_arguments) &&
+         (error_argument<std::decay_t<const arguments_&>> && ...)
+      constexpr error(code_ code, const arguments_&... arguments) noexcept :
+         m_id{make_id(error_category<code_>::id, static_cast<std::uint16_t>(code))}
+      {
+         detail::register_error_category<code_>();
+
+         [[maybe_unused]] std::size_t index = 0;
+         ((capture(m_arguments[index], m_kinds[index], arguments), ++index), ...);
+      }
+      /**
+       * An error of the generic category, whose message is the one of the std::errc
+       */
+      constexpr error(std::errc code) noexcept : error{generic_id(code), code} {}
+      /**
+       * An error of the generic category, from the generic condition of the code of the
+       * exception
+       */
+      explicit error(const std::system_error& e) noexcept :
+         error{static_cast<std::errc>(e.code().default_error_condition().value())}
+      {}
+
+      [[nodiscard]] constexpr auto id() const noexcept -> std::uint32_t { return m_id; }
+      [[nodiscard]] constexpr auto category() const noexcept -> std::uint16_t
+      {
+         return static_cast<std::uint16_t>(m_id >> 16U);
+      }
+      [[nodiscard]] constexpr auto code() const noexcept -> std::uint16_t
+      {
+         return static_cast<std::uint16_t>(m_id & 0xFFFFU);
+      }
+
+      [[nodiscard]] auto category_name() const noexcept -> std::string_view
+      {
+         const auto* info = category_info();
+
+         return info != nullptr ? info->name : std::string_view{"unregistered"};
+      }
+
+      /**
+       * Render the message of the code with the captured arguments
+       */
+      [[nodiscard]] auto message() const -> std::string
+      {
+         const auto* info = category_info();
+         const auto pattern = info != nullptr ? info->message(code()) : std::string_view{};
+
+         std::string out;
+
+         if (pattern.empty())
+         {
+            out.append(category_name()).append(" error ");
+            append_number(out, code());
+
+            return out;
+         }
+
+         std::size_t position = 0;
+         for (std::size_t index = 0; index < max_arguments && m_kinds[index] != kind::none;
+              ++index)
+         {
+            const auto placeholder = pattern.find("{}", position);
+            if (placeholder == std::string_view::npos)
+            {
+               break;
+            }
+
+            out.append(pattern.substr(position, placeholder - position));
+            append_argument(out, index);
+            position = placeholder + 2;
+         }
+
+         out.append(pattern.substr(position));
+
+         return out;
+      }
+
+      friend constexpr auto operator==(const error& lhs, const error& rhs) noexcept -> bool
+      {
+         return lhs.m_id == rhs.m_id;
+      }
+      template <error_code_enum code_>
+      friend constexpr auto operator==(const error& lhs, code_ rhs) noexcept -> bool
+      {
+         return lhs.m_id == make_id(error_category<code_>::id, static_cast<std::uint16_t>(rhs));
+      }
+      friend constexpr auto operator==(const error& lhs, std::errc rhs) noexcept -> bool
+      {
+         return lhs.m_id == generic_id(rhs).m_id;
+      }
+
+   private:
+      enum class kind : std::uint8_t
+      {
+         none,
+         signed_integer,
+         unsigned_integer,
+         floating_point,
+         boolean,
+         character,
+         text,
+         errc
+      };
+
+      union argument
+      {
+         std::int64_t signed_integer;
+         std::uint64_t unsigned_integer;
+         double floating_point;
+         const char* text;
+      };
+
+      struct raw_id
+      {
+         std::uint32_t m_id;
+      };
+
+      constexpr explicit error(raw_id id) noexcept : m_id{id.m_id} {}
+      constexpr error(raw_id id, std::errc code) noexcept : error{id}
+      {
+         capture(m_arguments[0], m_kinds[0], code);
+      }
+
+      static constexpr auto make_id(std::uint16_t category, std::uint16_t code) noexcept
+         -> std::uint32_t
+      {
+         return (std::uint32_t{category} << 16U) | code;
+      }
+      static constexpr auto generic_id(std::errc code) noexcept -> raw_id
+      {
+         return {make_id(0, static_cast<std::uint16_t>(code))};
+      }
+
+      [[nodiscard]] auto category_info() const noexcept -> const detail::error_category_info*
+      {
+         return category() < error_category_capacity
+                   ? detail::error_categories[category()].load(std::memory_order_acquire)
+                   : nullptr;
+      }
+
+      template <class argument_>
+      static constexpr void capture(argument& slot, kind& slot_kind,
+                                    const argument_& value) noexcept
+      {
+         using type = std::decay_t<const argument_&>;
+
+         if constexpr (std::is_same_v<type, bool>)
+         {
+            slot_kind = kind::boolean;
+            slot.unsigned_integer = value ? 1U : 0U;
+         }
+         else if constexpr (std::is_same_v<type, char>)
+         {
+            slot_kind = kind::character;
+            slot.signed_integer = value;
+         }
+         else if constexpr (std::is_same_v<type, std::errc>)
+         {
+            slot_kind = kind::errc;
+            slot.signed_integer = static_cast<std::int64_t>(value);
+         }
+         else if constexpr (std::is_floating_point_v<type>)
+         {
+            slot_kind = kind::floating_point;
+            slot.floating_point = static_cast<double>(value);
+         }
+         else if constexpr (std::is_signed_v<type>)
+         {
+            slot_kind = kind::signed_integer;
+            slot.signed_integer = value;
+         }
+         else if constexpr (std::is_unsigned_v<type>)
+         {
+            slot_kind = kind::unsigned_integer;
+            slot.unsigned_integer = value;
+         }
+         else
+         {
+            slot_kind = kind::text;
+            slot.text = value;
+         }
+      }
+
+      static void append_number(std::string& out, auto value)
+      {
+         std::array<char, 32> buffer{};
+         const auto converted = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+         out.append(buffer.data(), converted.ptr);
+      }
+
+      void append_argument(std::string& out, std::size_t index) const
+      {
+         const auto& slot = m_arguments[index];
+
+         switch (m_kinds[index])
+         {
+            case kind::signed_integer:
+               append_number(out, slot.signed_integer);
+               break;
+            case kind::unsigned_integer:
+               append_number(out, slot.unsigned_integer);
+               break;
+            case kind::floating_point:
+               append_number(out, slot.floating_point);
+               break;
+            case kind::boolean:
+               out.append(slot.unsigned_integer != 0 ? "true" : "false");
+               break;
+            case kind::character:
+               out.push_back(static_cast<char>(slot.signed_integer));
+               break;
+            case kind::text:
+               out.append(slot.text != nullptr ? slot.text : "");
+               break;
+            case kind::errc:
+               out.append(
+                  std::make_error_code(static_cast<std::errc>(slot.signed_integer)).message());
+               break;
+            case kind::none:
+               break;
+         }
+      }
+
+   private:
+      std::uint32_t m_id;
+      std::array<kind, max_arguments> m_kinds{};
+      std::array<argument, max_arguments> m_arguments{};
+
+      friend struct niche<error>;
+   };
+
+   /**
+    * An id no category can produce marks the empty maybe<error>, so that result<void, error> is
+    * no larger than the error
+    */
+   template <>
+   struct niche<error>
+   {
+      static constexpr auto none() noexcept -> error { return error{error::raw_id{0xFFFFFFFFU}}; }
+      static constexpr auto is_none(const error& value) noexcept -> bool
+      {
+         return value.m_id == 0xFFFFFFFFU;
+      }
+   };
+
+   namespace detail
+   {
+      /**
+       * try_wrap<error> catches the errors thrown as they are and the system errors as their
+       * generic code
+       */
+      template <>
+      struct caught_exceptions<error>
+      {
+         static constexpr bool is_sum = false;
+
+         using type = std::tuple<error, std::system_error>;
+      };
+   } // namespace detail
+
+   MONADS_ABI_END
+} // namespace monad
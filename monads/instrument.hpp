@@ -0,0 +1,218 @@
+#pragma once
+
+// Error path instrumentation. When MONADS_INSTRUMENT is defined, make_error, the error
+// propagation of result::and_then and the empty branch of maybe::or_else report an error_event
+// carrying their call site to a hook. The hook is the function named by MONADS_INSTRUMENT_HOOK,
+// or thread_error_counters::record if it is not defined. Instrumented functions take an extra
+// defaulted std::source_location parameter. Instrumentation is a whole program setting: it also
+// changes the bodies of templates whose signatures stay the same, so the instrumented library is
+// declared in its own inline namespace (see abi.hpp) and does not share any entity with a plain
+// build. When MONADS_INSTRUMENT is not defined, none of this is compiled in.
+
+#include "monads/abi.hpp"
+
+#if defined(MONADS_INSTRUMENT)
+
+#  include <array>
+#  include <cstddef>
+#  include <cstdint>
+#  include <source_location>
+#  include <span>
+#  include <type_traits>
+
+#  define MONADS_CALL_SITE , const std::source_location& call_site = std::source_location::current()
+#  define MONADS_RECORD_ERROR(kind, error_type)                                                   \
+     ::monad::detail::record_error<error_type>(::monad::error_event_kind::kind, call_site)
+
+namespace monad
+{
+   MONADS_ABI_BEGIN
+
+   enum class error_event_kind : std::uint8_t
+   {
+      made,
+      propagated,
+      recovered
+   };
+
+   /**
+    * Identifies the error type of an event without relying on RTTI
+    */
+   class error_type_id
+   {
+   public:
+      constexpr error_type_id() noexcept = default;
+
+      template <class error_>
+      static constexpr auto of() noexcept -> error_type_id
+      {
+         return error_type_id{&tag<std::remove_cvref_t<error_>>, signature<error_>()};
+      }
+
+      /**
+       * A compiler specific signature naming the type, for reports
+       */
+      [[nodiscard]] constexpr auto name() const noexcept -> const char* { return m_name; }
+
+      constexpr auto operator==(const error_type_id& other) const noexcept -> bool
+      {
+         return m_tag == other.m_tag;
+      }
+
+      [[nodiscard]] auto hash() const noexcept -> std::size_t
+      {
+         return reinterpret_cast<std::uintptr_t>(m_tag);
+      }
+
+   private:
+      constexpr error_type_id(const void* tag, const char* name) noexcept :
+         m_tag{tag}, m_name{name}
+      {}
+
+      template <class error_>
+      static constexpr auto signature() noexcept -> const char*
+      {
+         return std::source_location::current().function_name();
+      }
+
+      template <class error_>
+      static constexpr char tag = 0;
+
+   private:
+      const void* m_tag{nullptr};
+      const char* m_name{""};
+   };
+
+   struct error_event
+   {
+      error_event_kind kind;
+      error_type_id type;
+      std::source_location location;
+   };
+
+   /**
+    * The default hook: counts the events of the calling thread per call site, error type and
+    * kind in a fixed size table, without locking or allocating. Events that do not fit in the
+    * table are only counted as dropped. A call site reached from several translation units may
+    * be counted in several entries
+    */
+   class thread_error_counters
+   {
+   public:
+      static constexpr std::size_t capacity = 256;
+
+      struct entry
+      {
+         error_event event;
+         std::uint64_t count;
+      };
+
+      static void record(const error_event& event) noexcept { local().add(event); }
+
+      /**
+       * The counters of the calling thread
+       */
+      static auto local() noexcept -> thread_error_counters&
+      {
+         thread_local thread_error_counters counters;
+
+         return counters;
+      }
+
+      [[nodiscard]] auto entries() const noexcept -> std::span<const entry>
+      {
+         return {m_entries.data(), m_size};
+      }
+
+      [[nodiscard]] auto dropped() const noexcept -> std::uint64_t { return m_dropped; }
+
+      void clear() noexcept
+      {
+         m_slots.fill(0);
+         m_size = 0;
+         m_dropped = 0;
+      }
+
+   private:
+      static constexpr std::size_t slot_count = 2 * capacity;
+
+      static auto same_site(const error_event& lhs, const error_event& rhs) noexcept -> bool
+      {
+         return lhs.kind == rhs.kind && lhs.type == rhs.type &&
+            lhs.location.line() == rhs.location.line() &&
+            lhs.location.column() == rhs.location.column() &&
+            lhs.location.file_name() == rhs.location.file_name();
+      }
+
+      static auto hash(const error_event& event) noexcept -> std::size_t
+      {
+         std::size_t h = event.type.hash() ^ static_cast<std::size_t>(event.kind);
+         h = h * 0x9E3779B97F4A7C15ULL + event.location.line();
+         h = h * 0x9E3779B97F4A7C15ULL + event.location.column();
+         h = h * 0x9E3779B97F4A7C15ULL +
+            reinterpret_cast<std::uintptr_t>(event.location.file_name());
+
+         return h ^ (h >> 29);
+      }
+
+      void add(const error_event& event) noexcept
+      {
+         for (std::size_t i = hash(event) % slot_count;; i = (i + 1) % slot_count)
+         {
+            if (m_slots[i] == 0)
+            {
+               if (m_size == capacity)
+               {
+                  ++m_dropped;
+
+                  return;
+               }
+
+               m_entries[m_size] = entry{event, 1};
+               m_slots[i] = static_cast<std::uint16_t>(++m_size);
+
+               return;
+            }
+
+            if (entry& e = m_entries[m_slots[i] - 1]; same_site(e.event, event))
+            {
+               ++e.count;
+
+               return;
+            }
+         }
+      }
+
+   private:
+      std::array<entry, capacity> m_entries{};
+      std::array<std::uint16_t, slot_count> m_slots{};
+      std::size_t m_size{0};
+      std::uint64_t m_dropped{0};
+   };
+
+   namespace detail
+   {
+      template <class error_>
+      constexpr void record_error(error_event_kind kind, const std::source_location& location)
+      {
+         if (!std::is_constant_evaluated())
+         {
+#  if defined(MONADS_INSTRUMENT_HOOK)
+            MONADS_INSTRUMENT_HOOK(error_event{kind, error_type_id::of<error_>(), location});
+#  else
+            thread_error_counters::record(
+               error_event{kind, error_type_id::of<error_>(), location});
+#  endif
+         }
+      }
+   } // namespace detail
+
+   MONADS_ABI_END
+} // namespace monad
+
+#else
+
+#  define MONADS_CALL_SITE
+#  define MONADS_RECORD_ERROR(kind, error_type) static_cast<void>(0)
+
+#endif
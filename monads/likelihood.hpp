@@ -0,0 +1,36 @@
+#pragma once
+
+// Branch likelihood policy of the combinators. By default the value branch of a combinator is
+// the expected one: it is marked [[likely]], the empty or error branch is marked [[unlikely]],
+// and errors forwarded unchanged are built in cold, out of line functions so that the success
+// path is laid out as straight-line code. Define MONADS_FAILURE_IS_LIKELY to invert the
+// attributes and keep the error construction inline, for workloads where failures dominate.
+
+#include "monads/abi.hpp"
+
+#if defined(MONADS_FAILURE_IS_LIKELY)
+#  define MONADS_SUCCESS_BRANCH [[unlikely]]
+#  define MONADS_FAILURE_BRANCH [[likely]]
+#  define MONADS_COLD
+#else
+#  define MONADS_SUCCESS_BRANCH [[likely]]
+#  define MONADS_FAILURE_BRANCH [[unlikely]]
+#  if defined(__GNUC__) || defined(__clang__)
+#    define MONADS_COLD [[gnu::cold, gnu::noinline]]
+#  else
+#    define MONADS_COLD
+#  endif
+#endif
+
+namespace monad
+{
+   MONADS_ABI_BEGIN
+
+#if defined(MONADS_FAILURE_IS_LIKELY)
+   inline constexpr bool failure_is_likely = true;
+#else
+   inline constexpr bool failure_is_likely = false;
+#endif
+
+   MONADS_ABI_END
+} // namespace monad
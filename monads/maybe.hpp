@@ -1,7 +1,13 @@
 #pragma once
 
+#include "monads/abi.hpp"
+#include "monads/allocator.hpp"
+#include "monads/instrument.hpp"
+#include "monads/likelihood.hpp"
+#include "monads/niche.hpp"
 #include "monads/type_traits.hpp"
 
+#include <array>
 #include <cassert>
 #include <compare>
 #include <functional>
@@ -10,10 +16,29 @@
 
 namespace monad
 {
+   MONADS_ABI_BEGIN
+
    // clang-format off
-   template <class any_> requires(!std::is_reference_v<any_>) 
+   template <class any_> requires(!std::is_rvalue_reference_v<any_>) 
    class maybe;
    // clang-format on
+
+   namespace detail
+   {
+      /**
+       * Tag selecting the constructors that build alternative index_ from the result of invoking
+       * a function. The function is invoked in the member initializer of the storage, so its
+       * return value is constructed in place without an intermediate move
+       */
+      template <std::size_t index_>
+      struct from_invoke_t
+      {
+         explicit from_invoke_t() = default;
+      };
+
+      template <std::size_t index_ = 0>
+      inline constexpr from_invoke_t<index_> from_invoke{};
+   } // namespace detail
    //
    template <>
    class maybe<void>
@@ -24,7 +49,7 @@ namespace monad
    static inline constexpr auto none = none_t{}; // NOLINT
 
    // clang-format off
-   template <class any_> requires(!std::is_reference_v<any_>) 
+   template <class any_> requires(!std::is_rvalue_reference_v<any_>) 
    class maybe
    // clang-format on
    {
@@ -66,7 +91,7 @@ namespace monad
          // clang-format on
 
       public:
-         constexpr storage() noexcept = default;
+         constexpr storage() noexcept : m_empty{} {}
          constexpr storage(const value_type& value) noexcept(is_nothrow_copy_value_constructible) :
             m_is_engaged{true}
          {
@@ -83,6 +108,13 @@ namespace monad
          {
             std::construct_at(pointer(), std::forward<decltype(args)>(args)...);
          }
+         constexpr storage(detail::from_invoke_t<0>, auto&& fun, auto&&... args) :
+            m_value(std::invoke(std::forward<decltype(fun)>(fun),
+                                 std::forward<decltype(args)>(args)...)),
+            m_is_engaged{true}
+         {}
+         constexpr storage(const storage&) requires trivially_copy_constructible<value_type> =
+            default;
          constexpr storage(const storage& rhs) noexcept(is_nothrow_copy_value_constructible) :
             m_is_engaged{rhs.engaged()}
          {
@@ -91,59 +123,68 @@ namespace monad
                std::construct_at(pointer(), rhs.value());
             }
          }
+         constexpr storage(storage&&) requires trivially_move_constructible<value_type> = default;
          constexpr storage(storage&& rhs) noexcept(is_nothrow_move_value_constructible) :
             m_is_engaged{rhs.engaged()}
          {
             if (engaged())
             {
-               std::construct_at(pointer(), std::move(rhs.value));
-               rhs.m_is_engaged = false;
+               std::construct_at(pointer(), std::move(rhs.value()));
+               rhs.reset();
             }
          }
-         ~storage() noexcept(is_nothrow_destructible)
+         constexpr storage(std::allocator_arg_t, const auto& allocator, const storage& rhs) :
+            m_is_engaged{rhs.engaged()}
          {
             if (engaged())
             {
-               std::destroy_at(pointer());
-               m_is_engaged = false;
+               std::uninitialized_construct_using_allocator(pointer(), allocator, rhs.value());
             }
          }
+         constexpr storage(std::allocator_arg_t, const auto& allocator, storage&& rhs) :
+            m_is_engaged{rhs.engaged()}
+         {
+            if (engaged())
+            {
+               std::uninitialized_construct_using_allocator(pointer(), allocator,
+                                                            std::move(rhs.value()));
+               rhs.reset();
+            }
+         }
+         ~storage() requires trivially_destructible<value_type> = default;
+         constexpr ~storage() noexcept(is_nothrow_destructible) { reset(); }
 
+         constexpr auto operator=(const storage&) -> storage& requires
+            trivially_copy_assignable<value_type> = default;
          constexpr auto operator=(const storage& rhs) noexcept(is_nothrow_copy_assignable)
             -> storage&
          {
             if (this != &rhs)
             {
-               if (engaged())
-               {
-                  std::destroy_at(pointer());
-               }
+               reset();
 
-               m_is_engaged = rhs.engaged();
-
-               if (m_is_engaged)
+               if (rhs.engaged())
                {
                   std::construct_at(pointer(), rhs.value());
+                  m_is_engaged = true;
                }
             }
 
             return *this;
          }
+         constexpr auto operator=(storage&&) -> storage& requires
+            trivially_move_assignable<value_type> = default;
          constexpr auto operator=(storage&& rhs) noexcept(is_nothrow_move_assignable) -> storage&
          {
             if (this != &rhs)
             {
-               if (engaged())
-               {
-                  std::destroy_at(pointer());
-               }
-
-               m_is_engaged = rhs.engaged();
-               rhs.m_is_engaged = false;
+               reset();
 
-               if (engaged())
+               if (rhs.engaged())
                {
                   std::construct_at(pointer(), std::move(rhs.value()));
+                  m_is_engaged = true;
+                  rhs.reset();
                }
             }
 
@@ -152,6 +193,30 @@ namespace monad
 
          [[nodiscard]] constexpr auto engaged() const noexcept -> bool { return m_is_engaged; }
 
+         constexpr void reset() noexcept(is_nothrow_destructible)
+         {
+            if (engaged())
+            {
+               std::destroy_at(pointer());
+               m_is_engaged = false;
+
+               if (std::is_constant_evaluated())
+               {
+                  std::construct_at(std::addressof(m_empty));
+               }
+            }
+         }
+
+         /**
+          * Construct the value in place, the storage must be disengaged
+          */
+         constexpr void emplace(auto&&... args) noexcept(
+            std::is_nothrow_constructible_v<value_type, decltype(args)...>)
+         {
+            std::construct_at(pointer(), std::forward<decltype(args)>(args)...);
+            m_is_engaged = true;
+         }
+
          constexpr void
          swap(storage& other) noexcept(is_nothrow_swappable) requires std::swappable<value_type>
          {
@@ -159,31 +224,24 @@ namespace monad
             {
                std::swap(value(), other.value());
             }
-
-            if (engaged() && !other.engaged())
+            else if (engaged())
             {
-               std::swap(m_is_engaged, other.m_is_engaged);
-               other.value() = value();
-
-               std::destroy_at(pointer());
+               std::construct_at(other.pointer(), std::move(value()));
+               other.m_is_engaged = true;
+               reset();
             }
-
-            if (!engaged() && other.engaged())
+            else if (other.engaged())
             {
-               std::swap(m_is_engaged, other.m_is_engaged);
-               value() = other.value();
-
-               std::destroy_at(other.pointer());
+               std::construct_at(pointer(), std::move(other.value()));
+               m_is_engaged = true;
+               other.reset();
             }
          }
 
-         constexpr auto pointer() noexcept -> value_type*
-         {
-            return reinterpret_cast<value_type*>(m_bytes.data()); // NOLINT
-         }
+         constexpr auto pointer() noexcept -> value_type* { return std::addressof(m_value); }
          constexpr auto pointer() const noexcept -> const value_type*
          {
-            return reinterpret_cast<const value_type*>(m_bytes.data()); // NOLINT
+            return std::addressof(m_value);
          }
 
          constexpr auto value() & noexcept -> value_type& { return *pointer(); }
@@ -201,50 +259,140 @@ namespace monad
          }
 
       private:
-         alignas(value_type) std::array<std::byte, sizeof(value_type)> m_bytes;
+         /**
+          * The placeholder is the active member while disengaged, so that copies of an empty
+          * storage remain valid in constant evaluation
+          */
+         union
+         {
+            std::byte m_empty;
+            value_type m_value;
+         };
          bool m_is_engaged{false};
       };
 
+      /**
+       * Storage for types with a sentinel value, the empty state is the sentinel itself
+       */
       template <class type_>
-      class storage<type_, std::enable_if_t<trivial<type_>>>
+      class storage<type_, std::enable_if_t<has_niche<type_> && value_niche<type_>>>
       {
       public:
          using value_type = type_;
 
          constexpr storage() noexcept = default;
-         constexpr storage(const value_type& value) noexcept : m_is_engaged{true}
+         constexpr storage(const value_type& value) noexcept : m_value{value} {}
+         constexpr storage(value_type&& value) noexcept : m_value{std::move(value)} {}
+         constexpr storage(std::in_place_t, auto&&... args) noexcept(
+            std::is_nothrow_constructible_v<value_type, decltype(args)...>) :
+            m_value(std::forward<decltype(args)>(args)...)
+         {}
+         constexpr storage(detail::from_invoke_t<0>, auto&& fun, auto&&... args) :
+            m_value(std::invoke(std::forward<decltype(fun)>(fun),
+                                 std::forward<decltype(args)>(args)...))
+         {}
+         constexpr storage(std::allocator_arg_t, const auto&, const storage& rhs) noexcept :
+            storage(rhs)
+         {}
+
+         [[nodiscard]] constexpr auto engaged() const noexcept -> bool
+         {
+            return !niche<value_type>::is_none(m_value);
+         }
+
+         constexpr void reset() noexcept { m_value = niche<value_type>::none(); }
+
+         /**
+          * The value is built before it replaces the sentinel, so that the storage stays empty if
+          * its construction throws
+          */
+         constexpr void emplace(auto&&... args) noexcept(
+            std::is_nothrow_constructible_v<value_type, decltype(args)...>)
+         {
+            m_value = value_type(std::forward<decltype(args)>(args)...);
+         }
+
+         constexpr void swap(storage& other) noexcept requires std::swappable<value_type>
+         {
+            std::swap(m_value, other.m_value);
+         }
+
+         constexpr auto pointer() noexcept -> value_type* { return std::addressof(m_value); }
+         constexpr auto pointer() const noexcept -> const value_type*
+         {
+            return std::addressof(m_value);
+         }
+
+         constexpr auto value() & noexcept -> value_type& { return m_value; }
+         constexpr auto value() const& noexcept -> const value_type& { return m_value; }
+         constexpr auto value() && noexcept -> value_type&& { return std::move(m_value); }
+         constexpr auto value() const&& noexcept -> const value_type&&
+         {
+            return std::move(m_value);
+         }
+
+      private:
+         value_type m_value{niche<value_type>::none()};
+      };
+
+      /**
+       * Storage for one byte types whose empty state is an invalid object representation. The
+       * empty state is only observable through the object representation, so this storage is not
+       * usable in constant evaluation
+       */
+      template <class type_>
+      class storage<type_,
+                    std::enable_if_t<has_niche<type_> && byte_niche<type_> && !value_niche<type_>>>
+      {
+      public:
+         using value_type = type_;
+
+         constexpr storage() noexcept = default;
+         constexpr storage(const value_type& value) noexcept
          {
             std::construct_at(pointer(), value);
          }
-         constexpr storage(value_type&& value) noexcept : m_is_engaged{true}
+         constexpr storage(value_type&& value) noexcept
          {
             std::construct_at(pointer(), std::move(value));
          }
-         constexpr storage(std::in_place_t, auto&&... args) noexcept : m_is_engaged{true}
+         constexpr storage(std::in_place_t, auto&&... args) noexcept(
+            std::is_nothrow_constructible_v<value_type, decltype(args)...>)
          {
             std::construct_at(pointer(), std::forward<decltype(args)>(args)...);
          }
+         constexpr storage(detail::from_invoke_t<0>, auto&& fun, auto&&... args)
+         {
+            std::construct_at(pointer(),
+                              std::invoke(std::forward<decltype(fun)>(fun),
+                                          std::forward<decltype(args)>(args)...));
+         }
+         constexpr storage(std::allocator_arg_t, const auto&, const storage& rhs) noexcept :
+            storage(rhs)
+         {}
 
-         [[nodiscard]] constexpr auto engaged() const noexcept -> bool { return m_is_engaged; }
+         [[nodiscard]] constexpr auto engaged() const noexcept -> bool
+         {
+            return m_bytes[0] != niche<value_type>::none_byte;
+         }
 
-         constexpr void swap(storage& other) noexcept requires std::swappable<value_type>
+         constexpr void reset() noexcept { m_bytes[0] = niche<value_type>::none_byte; }
+
+         /**
+          * The value is built before it replaces the empty byte, so that the storage stays empty
+          * if its construction throws
+          */
+         constexpr void emplace(auto&&... args) noexcept(
+            std::is_nothrow_constructible_v<value_type, decltype(args)...>)
          {
-            if (engaged() && other.engaged())
-            {
-               std::swap(value(), other.value());
-            }
+            const value_type value(std::forward<decltype(args)>(args)...);
 
-            if (engaged() && !other.engaged())
-            {
-               std::swap(m_is_engaged, other.m_is_engaged);
-               other.value() = value();
-            }
+            std::construct_at(pointer(), value);
+         }
 
-            if (!engaged() && other.engaged())
-            {
-               std::swap(m_is_engaged, other.m_is_engaged);
-               value() = other.value();
-            }
+         constexpr void swap(storage& other) noexcept requires std::swappable<value_type>
+         {
+            std::swap(m_bytes, other.m_bytes);
          }
 
          constexpr auto pointer() noexcept -> value_type*
@@ -265,8 +413,8 @@ namespace monad
          }
 
       private:
-         alignas(value_type) std::array<std::byte, sizeof(value_type)> m_bytes;
-         bool m_is_engaged{false};
+         alignas(value_type) std::array<std::byte, sizeof(value_type)> m_bytes{
+            niche<value_type>::none_byte};
       };
 
       using storage_type = storage<any_>;
@@ -303,6 +451,32 @@ namespace monad
          m_storage{u, std::forward<decltype(args)>(args)...}
       {}
 
+      /**
+       * Allocator-extended constructors, the value is built with uses-allocator construction
+       */
+      constexpr maybe(std::allocator_arg_t, const auto&) noexcept {}
+      constexpr maybe(std::allocator_arg_t, const auto&, none_t) noexcept {}
+      constexpr maybe(std::allocator_arg_t, const auto& allocator, const value_type& value) :
+         m_storage{detail::from_invoke<0>, detail::construct_using_allocator<value_type>, allocator,
+                   value}
+      {}
+      constexpr maybe(std::allocator_arg_t, const auto& allocator, value_type&& value) :
+         m_storage{detail::from_invoke<0>, detail::construct_using_allocator<value_type>, allocator,
+                   std::move(value)}
+      {}
+      constexpr maybe(std::allocator_arg_t, const auto& allocator, std::in_place_t,
+                      auto&&... args)
+         requires std::constructible_from<value_type, decltype(args)...> :
+         m_storage{detail::from_invoke<0>, detail::construct_using_allocator<value_type>, allocator,
+                   std::forward<decltype(args)>(args)...}
+      {}
+      constexpr maybe(std::allocator_arg_t tag, const auto& allocator, const maybe& other) :
+         m_storage{tag, allocator, other.m_storage}
+      {}
+      constexpr maybe(std::allocator_arg_t tag, const auto& allocator, maybe&& other) :
+         m_storage{tag, allocator, std::move(other.m_storage)}
+      {}
+
       /**
        * Access the stored value
        */
@@ -415,7 +589,7 @@ namespace monad
       value_or(std::convertible_to<value_type> auto&& default_value) const& -> value_type
       {
          return has_value()
-            ? value()
+            ? detail::keep_allocator(value())
             : static_cast<value_type>(std::forward<decltype(default_value)>(default_value));
       }
       /**
@@ -438,11 +612,21 @@ namespace monad
        */
       constexpr void reset() noexcept(std::is_nothrow_destructible_v<value_type>)
       {
-         if (has_value())
-         {
-            std::destroy_at(m_storage.pointer());
-            m_storage.has_value = false;
-         }
+         m_storage.reset();
+      }
+
+      /**
+       * Destroy the stored value if it exists and construct a new one in place from the
+       * arguments. The maybe is left empty if the construction throws
+       */
+      constexpr auto emplace(auto&&... args) noexcept(
+         std::is_nothrow_constructible_v<value_type, decltype(args)...>) -> value_type& requires
+         std::constructible_from<value_type, decltype(args)...>
+      {
+         m_storage.reset();
+         m_storage.emplace(std::forward<decltype(args)>(args)...);
+
+         return m_storage.value();
       }
 
       /**
@@ -452,9 +636,15 @@ namespace monad
       {
          using result_type = std::invoke_result_t<decltype(fun), value_type>;
 
-         return !has_value()
-            ? maybe<result_type>{}
-            : maybe<result_type>{std::invoke(std::forward<decltype(fun)>(fun), value())};
+         if (has_value()) MONADS_SUCCESS_BRANCH
+         {
+            return maybe<result_type>{
+               detail::from_invoke<>, std::forward<decltype(fun)>(fun), value()};
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            return maybe<result_type>{};
+         }
       }
       /**
        * Carries out some operation on the stored object if there is one
@@ -463,9 +653,15 @@ namespace monad
       {
          using result_type = std::invoke_result_t<decltype(fun), value_type>;
 
-         return !has_value()
-            ? maybe<result_type>{}
-            : maybe<result_type>{std::invoke(std::forward<decltype(fun)>(fun), value())};
+         if (has_value()) MONADS_SUCCESS_BRANCH
+         {
+            return maybe<result_type>{
+               detail::from_invoke<>, std::forward<decltype(fun)>(fun), value()};
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            return maybe<result_type>{};
+         }
       }
       /**
        * Carries out some operation on the stored object if there is one
@@ -474,9 +670,15 @@ namespace monad
       {
          using result_type = std::invoke_result_t<decltype(fun), value_type>;
 
-         return !has_value()
-            ? maybe<result_type>{}
-            : maybe<result_type>{std::invoke(std::forward<decltype(fun)>(fun), std::move(value()))};
+         if (has_value()) MONADS_SUCCESS_BRANCH
+         {
+            return maybe<result_type>{
+               detail::from_invoke<>, std::forward<decltype(fun)>(fun), std::move(value())};
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            return maybe<result_type>{};
+         }
       }
       /**
        * Carries out some operation on the stored object if there is one
@@ -485,9 +687,15 @@ namespace monad
       {
          using result_type = std::invoke_result_t<decltype(fun), value_type>;
 
-         return !has_value()
-            ? maybe<result_type>{}
-            : maybe<result_type>{std::invoke(std::forward<decltype(fun)>(fun), std::move(value()))};
+         if (has_value()) MONADS_SUCCESS_BRANCH
+         {
+            return maybe<result_type>{
+               detail::from_invoke<>, std::forward<decltype(fun)>(fun), std::move(value())};
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            return maybe<result_type>{};
+         }
       }
 
       /**
@@ -497,7 +705,7 @@ namespace monad
       constexpr auto
       map_or(std::invocable<value_type> auto&& fun,
              std::convertible_to<std::invoke_result_t<decltype(fun), value_type>> auto&& other)
-         const& -> decltype(other)
+         const& -> std::remove_cvref_t<std::invoke_result_t<decltype(fun), value_type>>
       {
          return has_value() ? std::invoke(std::forward<decltype(fun)>(fun), value())
                             : std::forward<decltype(other)>(other);
@@ -509,7 +717,7 @@ namespace monad
       constexpr auto
       map_or(std::invocable<value_type> auto&& fun,
              std::convertible_to<std::invoke_result_t<decltype(fun), value_type>> auto&&
-                other) & -> decltype(other)
+                other) & -> std::remove_cvref_t<std::invoke_result_t<decltype(fun), value_type>>
       {
          return has_value() ? std::invoke(std::forward<decltype(fun)>(fun), value())
                             : std::forward<decltype(other)>(other);
@@ -521,7 +729,7 @@ namespace monad
       constexpr auto
       map_or(std::invocable<value_type> auto&& fun,
              std::convertible_to<std::invoke_result_t<decltype(fun), value_type>> auto&& other)
-         const&& -> decltype(other)
+         const&& -> std::remove_cvref_t<std::invoke_result_t<decltype(fun), value_type>>
       {
          return has_value() ? std::invoke(std::forward<decltype(fun)>(fun), std::move(value()))
                             : std::forward<decltype(other)>(other);
@@ -533,7 +741,7 @@ namespace monad
       constexpr auto
       map_or(std::invocable<value_type> auto&& fun,
              std::convertible_to<std::invoke_result_t<decltype(fun), value_type>> auto&&
-                other) && -> decltype(other)
+                other) && -> std::remove_cvref_t<std::invoke_result_t<decltype(fun), value_type>>
       {
          return has_value() ? std::invoke(std::forward<decltype(fun)>(fun), std::move(value()))
                             : std::forward<decltype(other)>(other);
@@ -545,10 +753,16 @@ namespace monad
        */
       constexpr auto and_then(std::invocable<value_type> auto&& fun) const&
       {
-         using result_type = typename std::invoke_result_t<decltype(fun), value_type>::value_type;
+         using result_type = std::remove_cvref_t<std::invoke_result_t<decltype(fun), value_type>>;
 
-         return !has_value() ? maybe<result_type>{}
-                             : std::invoke(std::forward<decltype(fun)>(fun), value());
+         if (has_value()) MONADS_SUCCESS_BRANCH
+         {
+            return std::invoke(std::forward<decltype(fun)>(fun), value());
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            return result_type{};
+         }
       }
       /**
        * Carries out some operation that returns a monad::maybe on the stored object
@@ -556,10 +770,16 @@ namespace monad
        */
       constexpr auto and_then(std::invocable<value_type> auto&& fun) &
       {
-         using result_type = typename std::invoke_result_t<decltype(fun), value_type>::value_type;
+         using result_type = std::remove_cvref_t<std::invoke_result_t<decltype(fun), value_type>>;
 
-         return !has_value() ? maybe<result_type>{}
-                             : std::invoke(std::forward<decltype(fun)>(fun), value());
+         if (has_value()) MONADS_SUCCESS_BRANCH
+         {
+            return std::invoke(std::forward<decltype(fun)>(fun), value());
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            return result_type{};
+         }
       }
       /**
        * Carries out some operation that returns a monad::maybe on the stored object
@@ -567,10 +787,16 @@ namespace monad
        */
       constexpr auto and_then(std::invocable<value_type> auto&& fun) const&&
       {
-         using result_type = typename std::invoke_result_t<decltype(fun), value_type>::value_type;
+         using result_type = std::remove_cvref_t<std::invoke_result_t<decltype(fun), value_type>>;
 
-         return !has_value() ? maybe<result_type>{}
-                             : std::invoke(std::forward<decltype(fun)>(fun), std::move(value()));
+         if (has_value()) MONADS_SUCCESS_BRANCH
+         {
+            return std::invoke(std::forward<decltype(fun)>(fun), std::move(value()));
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            return result_type{};
+         }
       }
       /**
        * Carries out some operation that returns a monad::maybe on the stored object
@@ -578,23 +804,31 @@ namespace monad
        */
       constexpr auto and_then(std::invocable<value_type> auto&& fun) &&
       {
-         using result_type = typename std::invoke_result_t<decltype(fun), value_type>::value_type;
+         using result_type = std::remove_cvref_t<std::invoke_result_t<decltype(fun), value_type>>;
 
-         return !has_value() ? maybe<result_type>{}
-                             : std::invoke(std::forward<decltype(fun)>(fun), value());
+         if (has_value()) MONADS_SUCCESS_BRANCH
+         {
+            return std::invoke(std::forward<decltype(fun)>(fun), std::move(value()));
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            return result_type{};
+         }
       }
 
       /**
        * Carries out an operation if there is no value stored
        */
-      constexpr auto or_else(std::invocable auto&& fun) const& -> maybe<value_type>
+      constexpr auto or_else(std::invocable auto&& fun MONADS_CALL_SITE) const& -> maybe<value_type>
       {
          if (has_value())
          {
-            return *this;
+            return detail::keep_allocator(m_storage.value());
          }
          else
          {
+            MONADS_RECORD_ERROR(recovered, none_t);
+
             std::invoke(std::forward<decltype(fun)>(fun));
 
             return none;
@@ -603,14 +837,16 @@ namespace monad
       /**
        * Carries out an operation if there is no value stored
        */
-      constexpr auto or_else(std::invocable auto&& fun) & -> maybe<value_type>
+      constexpr auto or_else(std::invocable auto&& fun MONADS_CALL_SITE) & -> maybe<value_type>
       {
          if (has_value())
          {
-            return *this;
+            return detail::keep_allocator(m_storage.value());
          }
          else
          {
+            MONADS_RECORD_ERROR(recovered, none_t);
+
             std::invoke(std::forward<decltype(fun)>(fun));
 
             return none;
@@ -619,7 +855,8 @@ namespace monad
       /**
        * Carries out an operation if there is no value stored
        */
-      constexpr auto or_else(std::invocable auto&& fun) const&& -> maybe<value_type>
+      constexpr auto or_else(std::invocable auto&& fun MONADS_CALL_SITE)
+         const&& -> maybe<value_type>
       {
          if (has_value())
          {
@@ -627,6 +864,8 @@ namespace monad
          }
          else
          {
+            MONADS_RECORD_ERROR(recovered, none_t);
+
             std::invoke(std::forward<decltype(fun)>(fun));
 
             return none;
@@ -635,7 +874,7 @@ namespace monad
       /**
        * Carries out an operation if there is no value stored
        */
-      constexpr auto or_else(std::invocable auto&& fun) && -> maybe<value_type>
+      constexpr auto or_else(std::invocable auto&& fun MONADS_CALL_SITE) && -> maybe<value_type>
       {
          if (has_value())
          {
@@ -643,6 +882,8 @@ namespace monad
          }
          else
          {
+            MONADS_RECORD_ERROR(recovered, none_t);
+
             std::invoke(std::forward<decltype(fun)>(fun));
 
             return none;
@@ -657,8 +898,8 @@ namespace monad
          const& -> std::invoke_result_t<decltype(def)> requires std::convertible_to<
             std::invoke_result_t<decltype(fun), value_type>, std::invoke_result_t<decltype(def)>>
       {
-         return has_value() ? std::invoke(std::forward<decltype(fun)>, value())
-                            : std::invoke(std::forward<decltype(def)>);
+         return has_value() ? std::invoke(std::forward<decltype(fun)>(fun), value())
+                            : std::invoke(std::forward<decltype(def)>(def));
       }
       /**
        * Carries out an operation on the stored object if there is one, or return
@@ -670,8 +911,8 @@ namespace monad
          convertible_to<std::invoke_result_t<decltype(fun), value_type>,
                         std::invoke_result_t<decltype(def)>>
       {
-         return has_value() ? std::invoke(std::forward<decltype(fun)>, value())
-                            : std::invoke(std::forward<decltype(def)>);
+         return has_value() ? std::invoke(std::forward<decltype(fun)>(fun), value())
+                            : std::invoke(std::forward<decltype(def)>(def));
       }
       /**
        * Carries out an operation on the stored object if there is one, or return
@@ -681,8 +922,8 @@ namespace monad
          const&& -> std::invoke_result_t<decltype(def)> requires std::convertible_to<
             std::invoke_result_t<decltype(fun), value_type>, std::invoke_result_t<decltype(def)>>
       {
-         return has_value() ? std::invoke(std::forward<decltype(fun)>, std::move(value()))
-                            : std::invoke(std::forward<decltype(def)>);
+         return has_value() ? std::invoke(std::forward<decltype(fun)>(fun), std::move(value()))
+                            : std::invoke(std::forward<decltype(def)>(def));
       }
       /**
        * Carries out an operation on the stored object if there is one, or return
@@ -693,12 +934,186 @@ namespace monad
          invoke_result_t<decltype(def)> requires std::convertible_to<
             std::invoke_result_t<decltype(fun), value_type>, std::invoke_result_t<decltype(def)>>
       {
-         return has_value() ? std::invoke(std::forward<decltype(fun)>, std::move(value()))
-                            : std::invoke(std::forward<decltype(def)>);
+         return has_value() ? std::invoke(std::forward<decltype(fun)>(fun), std::move(value()))
+                            : std::invoke(std::forward<decltype(def)>(def));
       }
 
+   private:
+      constexpr maybe(detail::from_invoke_t<0> tag, auto&& fun, auto&&... args) :
+         m_storage{tag, std::forward<decltype(fun)>(fun), std::forward<decltype(args)>(args)...}
+      {}
+
    private:
       storage<value_type> m_storage{};
+
+      // clang-format off
+      template <class other_> requires(!std::is_rvalue_reference_v<other_>)
+      friend class maybe;
+      // clang-format on
+   };
+
+   /**
+    * A maybe holding a reference, stored as a single nullable pointer. Assigning a maybe<T&>
+    * rebinds the reference instead of assigning through it
+    */
+   template <class any_>
+   class maybe<any_&>
+   {
+   public:
+      using value_type = any_;
+      using reference = any_&;
+
+      constexpr maybe() noexcept = default;
+      constexpr maybe(none_t) noexcept {}
+      constexpr maybe(reference value) noexcept : m_pointer{std::addressof(value)} {}
+      constexpr maybe(std::remove_cv_t<any_>&&) = delete;
+
+      /**
+       * Access the referenced value
+       */
+      constexpr auto operator->() const noexcept -> value_type*
+      {
+         assert(has_value());
+
+         return m_pointer;
+      }
+
+      /**
+       * Return the referenced value
+       */
+      constexpr auto operator*() const noexcept -> reference { return *m_pointer; }
+
+      /**
+       * Check if a value is referenced
+       */
+      [[nodiscard]] constexpr auto has_value() const noexcept -> bool
+      {
+         return m_pointer != nullptr;
+      }
+      constexpr operator bool() const noexcept { return has_value(); }
+
+      /**
+       * Return the referenced value
+       */
+      constexpr auto value() const noexcept -> reference
+      {
+         assert(has_value());
+
+         return *m_pointer;
+      }
+
+      /**
+       * Return a copy of the referenced value or a specified value
+       */
+      constexpr auto
+      value_or(std::convertible_to<std::remove_cv_t<value_type>> auto&& default_value) const
+         -> std::remove_cv_t<value_type>
+      {
+         return has_value() ? *m_pointer
+                            : static_cast<std::remove_cv_t<value_type>>(
+                                 std::forward<decltype(default_value)>(default_value));
+      }
+
+      constexpr void swap(maybe& other) noexcept { std::swap(m_pointer, other.m_pointer); }
+
+      /**
+       * Stop referencing the value
+       */
+      constexpr void reset() noexcept { m_pointer = nullptr; }
+
+      /**
+       * Carries out some operation on the referenced object if there is one
+       */
+      constexpr auto map(std::invocable<reference> auto&& fun) const
+      {
+         using result_type = std::invoke_result_t<decltype(fun), reference>;
+
+         if (has_value()) MONADS_SUCCESS_BRANCH
+         {
+            return maybe<result_type>{
+               detail::from_invoke<>, std::forward<decltype(fun)>(fun), *m_pointer};
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            return maybe<result_type>{};
+         }
+      }
+
+      /**
+       * Carries out an operation on the referenced object if there is one, or returns
+       * a default value
+       */
+      constexpr auto
+      map_or(std::invocable<reference> auto&& fun,
+             std::convertible_to<std::invoke_result_t<decltype(fun), reference>> auto&& other) const
+         -> std::remove_cvref_t<std::invoke_result_t<decltype(fun), reference>>
+      {
+         return has_value() ? std::invoke(std::forward<decltype(fun)>(fun), *m_pointer)
+                            : std::forward<decltype(other)>(other);
+      }
+
+      /**
+       * Carries out some operation that returns a monad::maybe on the referenced object
+       * if there is one
+       */
+      constexpr auto and_then(std::invocable<reference> auto&& fun) const
+      {
+         using result_type = std::remove_cvref_t<std::invoke_result_t<decltype(fun), reference>>;
+
+         if (has_value()) MONADS_SUCCESS_BRANCH
+         {
+            return std::invoke(std::forward<decltype(fun)>(fun), *m_pointer);
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            return result_type{};
+         }
+      }
+
+      /**
+       * Carries out an operation if there is no value referenced
+       */
+      constexpr auto or_else(std::invocable auto&& fun MONADS_CALL_SITE) const -> maybe
+      {
+         if (has_value())
+         {
+            return *this;
+         }
+         else
+         {
+            MONADS_RECORD_ERROR(recovered, none_t);
+
+            std::invoke(std::forward<decltype(fun)>(fun));
+
+            return none;
+         }
+      }
+
+      /**
+       * Carries out an operation on the referenced object if there is one, or return
+       * a the result of a given function
+       */
+      constexpr auto map_or_else(std::invocable<reference> auto&& fun, std::invocable auto&& def)
+         const -> std::invoke_result_t<decltype(def)> requires std::convertible_to<
+            std::invoke_result_t<decltype(fun), reference>, std::invoke_result_t<decltype(def)>>
+      {
+         return has_value() ? std::invoke(std::forward<decltype(fun)>(fun), *m_pointer)
+                            : std::invoke(std::forward<decltype(def)>(def));
+      }
+
+   private:
+      constexpr maybe(detail::from_invoke_t<0>, auto&& fun, auto&&... args) :
+         m_pointer{std::addressof(std::invoke(std::forward<decltype(fun)>(fun),
+                                              std::forward<decltype(args)>(args)...))}
+      {}
+
+   private:
+      value_type* m_pointer{nullptr};
+
+      // clang-format off
+      template <class other_> requires(!std::is_rvalue_reference_v<other_>)
+      friend class maybe;
+      // clang-format on
    };
 
    template <class any_>
@@ -765,6 +1180,8 @@ namespace monad
    {
       return m.has_value() ? m.value() <=> value : std::strong_ordering::less;
    }
+
+   MONADS_ABI_END
 } // namespace monad
 
 namespace std // NOLINT
@@ -775,4 +1192,9 @@ namespace std // NOLINT
    {
       lhs.swap(rhs);
    }
+
+   template <class any_, class allocator_>
+   struct uses_allocator<monad::maybe<any_>, allocator_> : uses_allocator<any_, allocator_>
+   {
+   };
 } // namespace std
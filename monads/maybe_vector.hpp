@@ -0,0 +1,388 @@
+#pragma once
+
+#include "monads/abi.hpp"
+#include "monads/maybe.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace monad
+{
+   MONADS_ABI_BEGIN
+
+   /**
+    * A sequence of maybe<T> stored as a structure of arrays: a dense buffer of values and a
+    * validity bitmap with one bit per element. Empty elements keep a value initialized T in the
+    * value buffer. bool is not supported, its vector packs the values into proxies
+    */
+   template <std::default_initializable any_>
+      requires(!std::same_as<any_, bool>)
+   class maybe_vector
+   {
+      using word_type = std::uint64_t;
+
+      static constexpr std::size_t word_bits = std::numeric_limits<word_type>::digits;
+
+      template <bool is_const_>
+      class iterator_base
+      {
+         using vector_type = std::conditional_t<is_const_, const maybe_vector, maybe_vector>;
+
+      public:
+         /**
+          * The elements are maybe references returned by value, which satisfies the random access
+          * iterator concept but only the requirements of a legacy input iterator
+          */
+         using iterator_concept = std::random_access_iterator_tag;
+         using iterator_category = std::input_iterator_tag;
+         using difference_type = std::ptrdiff_t;
+         using value_type = maybe<std::conditional_t<is_const_, const any_&, any_&>>;
+         using reference = value_type;
+
+         constexpr iterator_base() noexcept = default;
+         constexpr iterator_base(vector_type* vector, std::size_t index) noexcept :
+            m_vector{vector}, m_index{index}
+         {}
+
+         constexpr auto operator*() const noexcept -> reference { return (*m_vector)[m_index]; }
+         constexpr auto operator[](difference_type n) const noexcept -> reference
+         {
+            return (*m_vector)[m_index + n];
+         }
+
+         constexpr auto operator++() noexcept -> iterator_base&
+         {
+            ++m_index;
+            return *this;
+         }
+         constexpr auto operator++(int) noexcept -> iterator_base
+         {
+            auto copy = *this;
+            ++m_index;
+            return copy;
+         }
+         constexpr auto operator--() noexcept -> iterator_base&
+         {
+            --m_index;
+            return *this;
+         }
+         constexpr auto operator--(int) noexcept -> iterator_base
+         {
+            auto copy = *this;
+            --m_index;
+            return copy;
+         }
+         constexpr auto operator+=(difference_type n) noexcept -> iterator_base&
+         {
+            m_index += n;
+            return *this;
+         }
+         constexpr auto operator-=(difference_type n) noexcept -> iterator_base&
+         {
+            m_index -= n;
+            return *this;
+         }
+
+         friend constexpr auto operator+(iterator_base it, difference_type n) noexcept
+            -> iterator_base
+         {
+            return it += n;
+         }
+         friend constexpr auto operator+(difference_type n, iterator_base it) noexcept
+            -> iterator_base
+         {
+            return it += n;
+         }
+         friend constexpr auto operator-(iterator_base it, difference_type n) noexcept
+            -> iterator_base
+         {
+            return it -= n;
+         }
+         friend constexpr auto operator-(const iterator_base& lhs,
+                                         const iterator_base& rhs) noexcept -> difference_type
+         {
+            return static_cast<difference_type>(lhs.m_index) -
+               static_cast<difference_type>(rhs.m_index);
+         }
+
+         friend constexpr auto operator==(const iterator_base& lhs,
+                                          const iterator_base& rhs) noexcept -> bool
+         {
+            return lhs.m_index == rhs.m_index;
+         }
+         friend constexpr auto operator<=>(const iterator_base& lhs,
+                                           const iterator_base& rhs) noexcept
+         {
+            return lhs.m_index <=> rhs.m_index;
+         }
+
+      private:
+         vector_type* m_vector{nullptr};
+         std::size_t m_index{0};
+      };
+
+   public:
+      using value_type = maybe<any_>;
+      using size_type = std::size_t;
+      using reference = maybe<any_&>;
+      using const_reference = maybe<const any_&>;
+      using iterator = iterator_base<false>;
+      using const_iterator = iterator_base<true>;
+
+      constexpr maybe_vector() = default;
+      /**
+       * Construct a vector of count empty elements
+       */
+      constexpr explicit maybe_vector(size_type count) :
+         m_values(count), m_validity(word_count(count)), m_size{count}
+      {}
+      constexpr maybe_vector(std::initializer_list<value_type> values)
+      {
+         reserve(values.size());
+
+         for (const auto& value : values)
+         {
+            push_back(value);
+         }
+      }
+
+      [[nodiscard]] constexpr auto size() const noexcept -> size_type { return m_size; }
+      [[nodiscard]] constexpr auto empty() const noexcept -> bool { return m_size == 0; }
+
+      constexpr void reserve(size_type capacity)
+      {
+         m_values.reserve(capacity);
+         m_validity.reserve(word_count(capacity));
+      }
+
+      constexpr void clear() noexcept
+      {
+         m_values.clear();
+         m_validity.clear();
+         m_size = 0;
+      }
+
+      constexpr void push_back(const value_type& value)
+      {
+         if (value.has_value())
+         {
+            emplace_back(value.value());
+         }
+         else
+         {
+            push_back(none);
+         }
+      }
+      constexpr void push_back(value_type&& value)
+      {
+         if (value.has_value())
+         {
+            emplace_back(std::move(value.value()));
+         }
+         else
+         {
+            push_back(none);
+         }
+      }
+      constexpr void push_back(none_t)
+      {
+         m_values.emplace_back();
+         grow_validity();
+      }
+      constexpr void emplace_back(auto&&... args)
+      {
+         m_values.emplace_back(std::forward<decltype(args)>(args)...);
+         grow_validity();
+         set_bit(m_size - 1);
+      }
+
+      /**
+       * Return a reference to the element if it is engaged
+       */
+      constexpr auto operator[](size_type index) noexcept -> reference
+      {
+         return has_value(index) ? reference{m_values[index]} : reference{};
+      }
+      /**
+       * Return a reference to the element if it is engaged
+       */
+      constexpr auto operator[](size_type index) const noexcept -> const_reference
+      {
+         return has_value(index) ? const_reference{m_values[index]} : const_reference{};
+      }
+
+      [[nodiscard]] constexpr auto has_value(size_type index) const noexcept -> bool
+      {
+         return (m_validity[index / word_bits] >> (index % word_bits)) & 1U;
+      }
+
+      /**
+       * Replace the element at index, engaging or disengaging it
+       */
+      constexpr void set(size_type index, const value_type& value)
+      {
+         if (value.has_value())
+         {
+            m_values[index] = value.value();
+            set_bit(index);
+         }
+         else
+         {
+            reset(index);
+         }
+      }
+      /**
+       * Disengage the element at index
+       */
+      constexpr void reset(size_type index)
+      {
+         m_values[index] = any_{};
+         m_validity[index / word_bits] &= ~(word_type{1} << (index % word_bits));
+      }
+
+      constexpr auto begin() noexcept -> iterator { return {this, 0}; }
+      constexpr auto begin() const noexcept -> const_iterator { return {this, 0}; }
+      constexpr auto end() noexcept -> iterator { return {this, m_size}; }
+      constexpr auto end() const noexcept -> const_iterator { return {this, m_size}; }
+
+      /**
+       * The dense value buffer, empty elements hold a value initialized T
+       */
+      constexpr auto values() const noexcept -> std::span<const any_> { return m_values; }
+      /**
+       * The validity bitmap, bit i % 64 of word i / 64 is set if element i is engaged. Bits past
+       * size() are always cleared
+       */
+      constexpr auto validity() const noexcept -> std::span<const word_type>
+      {
+         return m_validity;
+      }
+
+      /**
+       * Count the number of engaged elements
+       */
+      [[nodiscard]] constexpr auto count_engaged() const noexcept -> size_type
+      {
+         size_type count = 0;
+
+         for (const word_type word : m_validity)
+         {
+            count += static_cast<size_type>(std::popcount(word));
+         }
+
+         return count;
+      }
+
+      /**
+       * Return the stored values, with empty elements replaced by a specified value. The value
+       * buffer is copied as a whole and only words of the bitmap with empty elements are visited
+       */
+      constexpr auto value_or(std::convertible_to<any_> auto&& default_value) const
+         -> std::vector<any_>
+      {
+         const auto fallback =
+            static_cast<any_>(std::forward<decltype(default_value)>(default_value));
+
+         std::vector<any_> result{m_values};
+
+         for (size_type w = 0; w < m_validity.size(); ++w)
+         {
+            const size_type first = w * word_bits;
+            const size_type last = std::min(first + word_bits, m_size);
+
+            for (word_type empty = ~m_validity[w]; empty != 0; empty &= empty - 1)
+            {
+               const size_type i = first + static_cast<size_type>(std::countr_zero(empty));
+
+               if (i >= last)
+               {
+                  break;
+               }
+
+               result[i] = fallback;
+            }
+         }
+
+         return result;
+      }
+
+      /**
+       * Carries out some operation on every engaged element. Runs of fully engaged elements are
+       * processed without testing the bitmap per element
+       */
+      constexpr auto map(std::invocable<const any_&> auto&& fun) const
+      {
+         using result_type = std::invoke_result_t<decltype(fun), const any_&>;
+
+         maybe_vector<result_type> result(m_size);
+
+         for (size_type w = 0; w < m_validity.size(); ++w)
+         {
+            const word_type word = m_validity[w];
+            const size_type first = w * word_bits;
+            const size_type last = std::min(first + word_bits, m_size);
+
+            if (word == ~word_type{0})
+            {
+               for (size_type i = first; i < last; ++i)
+               {
+                  result.m_values[i] = std::invoke(fun, m_values[i]);
+               }
+            }
+            else if (word != 0)
+            {
+               for (size_type i = first; i < last; ++i)
+               {
+                  if ((word >> (i - first)) & 1U)
+                  {
+                     result.m_values[i] = std::invoke(fun, m_values[i]);
+                  }
+               }
+            }
+
+            result.m_validity[w] = word;
+         }
+
+         return result;
+      }
+
+   private:
+      static constexpr auto word_count(size_type count) noexcept -> size_type
+      {
+         return (count + word_bits - 1) / word_bits;
+      }
+
+      constexpr void grow_validity()
+      {
+         if (m_size % word_bits == 0)
+         {
+            m_validity.push_back(0);
+         }
+
+         ++m_size;
+      }
+
+      constexpr void set_bit(size_type index) noexcept
+      {
+         m_validity[index / word_bits] |= word_type{1} << (index % word_bits);
+      }
+
+   private:
+      std::vector<any_> m_values;
+      std::vector<word_type> m_validity;
+      size_type m_size{0};
+
+      template <std::default_initializable other_>
+         requires(!std::same_as<other_, bool>)
+      friend class maybe_vector;
+   };
+
+   MONADS_ABI_END
+} // namespace monad
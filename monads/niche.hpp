@@ -0,0 +1,130 @@
+#pragma once
+
+#include "monads/abi.hpp"
+#include "monads/type_traits.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace monad
+{
+   MONADS_ABI_BEGIN
+
+   /**
+    * Customization point describing a bit pattern of a type that never represents a valid value.
+    * When a type has a niche, monad::maybe stores the empty state inside the value itself instead
+    * of carrying a separate engaged flag, so that sizeof(maybe<T>) == sizeof(T).
+    *
+    * The primary template describes a type without a niche. Specializations provide either
+    *
+    *    static constexpr auto none() noexcept -> any_;
+    *    static constexpr auto is_none(const any_&) noexcept -> bool;
+    *
+    * for a sentinel value, or
+    *
+    *    static constexpr std::byte none_byte;
+    *
+    * for one-byte types whose sentinel is not a valid object representation (such as bool).
+    */
+   template <class any_>
+   struct niche
+   {
+   };
+
+   /**
+    * Helper to declare a user provided sentinel value for a type, for instance
+    *
+    *    template <>
+    *    struct monad::niche<user_id> : monad::sentinel_niche<user_id, user_id{0}> {};
+    */
+   template <class any_, any_ sentinel_>
+   struct sentinel_niche
+   {
+      static constexpr auto none() noexcept -> any_ { return sentinel_; }
+      static constexpr auto is_none(const any_& value) noexcept -> bool
+      {
+         return value == sentinel_;
+      }
+   };
+
+   /**
+    * Helper to declare the largest value of the underlying type as the sentinel of an enum, for
+    * enums whose enumerators never use it
+    */
+   template <class any_>
+      requires std::is_enum_v<any_>
+   struct enum_niche :
+      sentinel_niche<any_,
+                     static_cast<any_>(std::numeric_limits<std::underlying_type_t<any_>>::max())>
+   {
+   };
+
+   /**
+    * A null pointer represents the empty state, a maybe<T*> constructed from nullptr is therefore
+    * equivalent to none
+    */
+   template <class any_>
+   struct niche<any_*> : sentinel_niche<any_*, nullptr>
+   {
+   };
+
+   template <>
+   struct niche<bool>
+   {
+      static constexpr std::byte none_byte{0xFF};
+   };
+
+   namespace detail
+   {
+      template <class float_, class bits_, bits_ pattern_>
+      struct nan_niche
+      {
+         static_assert(std::numeric_limits<float_>::is_iec559);
+         static_assert(sizeof(float_) == sizeof(bits_));
+
+         static constexpr auto none() noexcept -> float_ { return std::bit_cast<float_>(pattern_); }
+         static constexpr auto is_none(const float_& value) noexcept -> bool
+         {
+            return std::bit_cast<bits_>(value) == pattern_;
+         }
+      };
+   } // namespace detail
+
+   /**
+    * A quiet NaN with a payload that arithmetic never produces on its own represents the empty
+    * state. Ordinary NaN values remain valid values
+    */
+   template <>
+   struct niche<float> : detail::nan_niche<float, std::uint32_t, 0x7FDE'AD01U>
+   {
+   };
+
+   template <>
+   struct niche<double> : detail::nan_niche<double, std::uint64_t, 0x7FF8'DEAD'BEEF'0001ULL>
+   {
+   };
+
+   // clang-format off
+   template <class any_>
+   concept value_niche = requires(const any_& value)
+   {
+      { niche<any_>::none() } -> std::same_as<any_>;
+      { niche<any_>::is_none(value) } -> std::same_as<bool>;
+   };
+
+   template <class any_>
+   concept byte_niche =
+      sizeof(any_) == 1 &&
+      requires { { niche<any_>::none_byte } -> std::convertible_to<std::byte>; };
+
+   template <class any_>
+   concept has_niche =
+      trivially_copyable<any_> &&
+      trivially_destructible<any_> &&
+      (value_niche<any_> || byte_niche<any_>);
+   // clang-format on
+
+   MONADS_ABI_END
+} // namespace monad
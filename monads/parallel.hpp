@@ -0,0 +1,209 @@
+#pragma once
+
+#include "monads/abi.hpp"
+#include "monads/maybe.hpp"
+#include "monads/result.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace monad
+{
+   MONADS_ABI_BEGIN
+
+   /**
+    * How par_traverse splits its input. A worker count of zero uses one worker per hardware
+    * thread, a chunk size of zero picks one from the size of the input and the worker count
+    */
+   struct par_policy
+   {
+      std::size_t workers{0};
+      std::size_t chunk_size{0};
+   };
+
+   inline constexpr par_policy par{};
+
+   namespace detail
+   {
+      template <class any_>
+      inline constexpr bool is_result = false;
+
+      template <class value_, class error_>
+      inline constexpr bool is_result<result<value_, error_>> = true;
+
+      template <class range_, class fun_>
+      using par_result_t =
+         std::remove_cvref_t<std::invoke_result_t<fun_&, std::ranges::range_reference_t<range_>>>;
+
+      // clang-format off
+      template <class range_, class fun_>
+      concept par_traversable = std::ranges::random_access_range<range_> &&
+         std::ranges::sized_range<range_> &&
+         is_result<par_result_t<range_, fun_>> &&
+         std::default_initializable<typename par_result_t<range_, fun_>::value_type> &&
+         !std::same_as<typename par_result_t<range_, fun_>::value_type, bool>;
+      // clang-format on
+
+      /**
+       * Shared between the workers of a single par_traverse call. Chunks are handed out in
+       * increasing order, and the lowest failing index acts as the cancellation flag: work past
+       * it is skipped, while work before it still runs since it may hold an earlier error
+       */
+      template <class error_>
+      class par_state
+      {
+      public:
+         explicit par_state(std::size_t size) : m_failed_at{size} {}
+
+         auto claim(std::size_t chunk_size) noexcept -> std::size_t
+         {
+            return m_next.fetch_add(chunk_size, std::memory_order_relaxed);
+         }
+
+         [[nodiscard]] auto is_cancelled(std::size_t index) const noexcept -> bool
+         {
+            return index >= m_failed_at.load(std::memory_order_relaxed);
+         }
+
+         void fail(std::size_t index, error_&& error)
+         {
+            const std::scoped_lock lock{m_mutex};
+
+            if (index < m_failed_at.load(std::memory_order_relaxed))
+            {
+               m_error = std::move(error);
+               m_failed_at.store(index, std::memory_order_relaxed);
+            }
+         }
+
+         void fail(std::size_t index, std::exception_ptr exception)
+         {
+            const std::scoped_lock lock{m_mutex};
+
+            if (!m_exception || index < m_exception_at)
+            {
+               m_exception = std::move(exception);
+               m_exception_at = index;
+            }
+
+            // an exception cancels every remaining chunk
+            m_failed_at.store(0, std::memory_order_relaxed);
+         }
+
+         auto take_exception() noexcept -> std::exception_ptr { return std::move(m_exception); }
+         auto take_error() -> maybe<error_> { return std::move(m_error); }
+
+      private:
+         std::atomic<std::size_t> m_next{0};
+         std::atomic<std::size_t> m_failed_at;
+
+         std::mutex m_mutex;
+         maybe<error_> m_error;
+         std::exception_ptr m_exception;
+         std::size_t m_exception_at{0};
+      };
+   } // namespace detail
+
+   /**
+    * Apply a function returning a result to every element of a random access range across a
+    * pool of workers, writing the values straight into a preallocated vector. A failure stops
+    * the workers from starting elements past it, and the error of the lowest failing index is
+    * returned so that the outcome does not depend on scheduling. An exception thrown by the
+    * function is rethrown on the calling thread once every worker has stopped
+    */
+   template <class range_, class fun_>
+      requires detail::par_traversable<range_, fun_>
+   auto par_traverse(par_policy policy, range_&& range, fun_&& fun) -> result<
+      std::vector<typename detail::par_result_t<range_, fun_>::value_type>,
+      typename detail::par_result_t<range_, fun_>::error_type>
+   {
+      using result_type = detail::par_result_t<range_, fun_>;
+      using value_type = typename result_type::value_type;
+      using error_type = typename result_type::error_type;
+
+      const auto size = static_cast<std::size_t>(std::ranges::size(range));
+      const auto first = std::ranges::begin(range);
+
+      std::vector<value_type> values(size);
+
+      if (size == 0)
+      {
+         return make_value(std::move(values));
+      }
+
+      const std::size_t hardware = std::max(std::thread::hardware_concurrency(), 1U);
+      const std::size_t workers =
+         std::min(policy.workers != 0 ? policy.workers : hardware, size);
+      const std::size_t chunk_size = policy.chunk_size != 0
+         ? policy.chunk_size
+         : std::max<std::size_t>(size / (workers * 8), 1);
+
+      detail::par_state<error_type> state{size};
+
+      const auto work = [&]() {
+         for (std::size_t begin = state.claim(chunk_size); begin < size;
+              begin = state.claim(chunk_size))
+         {
+            const std::size_t end = std::min(begin + chunk_size, size);
+
+            for (std::size_t i = begin; i < end && !state.is_cancelled(i); ++i)
+            {
+               try
+               {
+                  auto next = std::invoke(fun, first[static_cast<std::ptrdiff_t>(i)]);
+
+                  if (!next.is_value())
+                  {
+                     state.fail(i, std::move(*next.error_ptr()));
+                     break;
+                  }
+
+                  values[i] = std::move(*next.value_ptr());
+               }
+               catch (...)
+               {
+                  state.fail(i, std::current_exception());
+                  return;
+               }
+            }
+         }
+      };
+
+      {
+         std::vector<std::jthread> pool;
+         pool.reserve(workers - 1);
+
+         for (std::size_t w = 1; w < workers; ++w)
+         {
+            pool.emplace_back(work);
+         }
+
+         // the calling thread is the last worker
+         work();
+      }
+
+      if (auto exception = state.take_exception())
+      {
+         std::rethrow_exception(exception);
+      }
+
+      // forwarded as it is, the function already made the error
+      if (auto error = state.take_error(); error.has_value())
+      {
+         return error_t<error_type>{std::move(error).value()};
+      }
+
+      return make_value(std::move(values));
+   }
+
+   MONADS_ABI_END
+} // namespace monad
@@ -0,0 +1,382 @@
+#pragma once
+
+#include "monads/abi.hpp"
+#include "monads/either.hpp"
+#include "monads/maybe.hpp"
+#include "monads/result.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace monad
+{
+   MONADS_ABI_BEGIN
+
+   namespace detail
+   {
+      template <class fun_>
+      struct map_stage
+      {
+         fun_ fun;
+      };
+
+      template <class fun_>
+      struct and_then_stage
+      {
+         fun_ fun;
+      };
+
+      template <class any_>
+      struct value_or_stage
+      {
+         any_ value;
+      };
+
+      /**
+       * Describes how a pipeline reads a monad, how it forwards a failure and how it builds a
+       * successful monad from the final value
+       */
+      template <class monad_>
+      struct pipe_traits;
+
+      template <class any_>
+      struct pipe_traits<maybe<any_>>
+      {
+         using value_type = any_;
+
+         template <class value_>
+         using rebind = maybe<value_>;
+
+         static constexpr auto has_value(const maybe<any_>& m) noexcept -> bool
+         {
+            return m.has_value();
+         }
+
+         template <class source_>
+         static constexpr auto value(source_&& m) noexcept -> decltype(auto)
+         {
+            return *std::forward<source_>(m);
+         }
+
+         template <class value_, class source_>
+         static constexpr auto failure(source_&&) noexcept -> maybe<value_>
+         {
+            return none;
+         }
+
+         template <class value_>
+         static constexpr auto success(value_&& value) -> maybe<std::remove_cvref_t<value_>>
+         {
+            return {std::in_place, std::forward<value_>(value)};
+         }
+      };
+
+      template <class value_, class error_>
+      struct pipe_traits<result<value_, error_>>
+      {
+         using value_type = value_;
+
+         template <class other_>
+         using rebind = result<other_, error_>;
+
+         static constexpr auto has_value(const result<value_, error_>& r) noexcept -> bool
+         {
+            return r.is_value();
+         }
+
+         template <class source_>
+         static constexpr auto value(source_&& r) noexcept -> decltype(auto)
+         {
+            if constexpr (std::is_lvalue_reference_v<source_>)
+            {
+               return *r.value_ptr();
+            }
+            else
+            {
+               return std::move(*r.value_ptr());
+            }
+         }
+
+         /**
+          * The error is forwarded, not made: it is built without make_error so that
+          * instrumentation does not record it a second time at this line
+          */
+         template <class other_, class source_>
+         static constexpr auto failure(source_&& r) -> result<other_, error_>
+         {
+            if constexpr (std::is_lvalue_reference_v<source_>)
+            {
+               return error_t<error_>{*r.error_ptr()};
+            }
+            else
+            {
+               return error_t<error_>{std::move(*r.error_ptr())};
+            }
+         }
+
+         template <class other_>
+         static constexpr auto success(other_&& value)
+            -> result<std::remove_cvref_t<other_>, error_>
+         {
+            return {std::in_place_index<0>, std::forward<other_>(value)};
+         }
+      };
+
+      /**
+       * An either is read as right biased, like its right_map and right_flat_map: a left value
+       * is a failure that stops the pipeline
+       */
+      template <class left_, class right_>
+      struct pipe_traits<either<left_, right_>>
+      {
+         using value_type = right_;
+
+         template <class other_>
+         using rebind = either<left_, other_>;
+
+         static constexpr auto has_value(const either<left_, right_>& e) noexcept -> bool
+         {
+            return e.is_right();
+         }
+
+         template <class source_>
+         static constexpr auto value(source_&& e) noexcept -> decltype(auto)
+         {
+            if constexpr (std::is_lvalue_reference_v<source_>)
+            {
+               return *e.right_ptr();
+            }
+            else
+            {
+               return std::move(*e.right_ptr());
+            }
+         }
+
+         template <class other_, class source_>
+         static constexpr auto failure(source_&& e) -> either<left_, other_>
+         {
+            if constexpr (std::is_lvalue_reference_v<source_>)
+            {
+               return {std::in_place_index<0>, *e.left_ptr()};
+            }
+            else
+            {
+               return {std::in_place_index<0>, std::move(*e.left_ptr())};
+            }
+         }
+
+         template <class other_>
+         static constexpr auto success(other_&& value) -> either<left_, std::remove_cvref_t<other_>>
+         {
+            return {std::in_place_index<1>, std::forward<other_>(value)};
+         }
+      };
+
+      template <class any_>
+      inline constexpr bool is_and_then_stage = false;
+
+      template <class fun_>
+      inline constexpr bool is_and_then_stage<and_then_stage<fun_>> = true;
+
+      template <class any_>
+      inline constexpr bool is_pipe_stage = is_and_then_stage<any_>;
+
+      template <class fun_>
+      inline constexpr bool is_pipe_stage<map_stage<fun_>> = true;
+
+      template <class value_, class stage_>
+      struct stage_output;
+
+      template <class value_, class fun_>
+      struct stage_output<value_, map_stage<fun_>>
+      {
+         using type = std::invoke_result_t<const fun_&, value_>;
+      };
+
+      template <class value_, class fun_>
+      struct stage_output<value_, and_then_stage<fun_>>
+      {
+         using type = typename pipe_traits<
+            std::remove_cvref_t<std::invoke_result_t<const fun_&, value_>>>::value_type;
+      };
+
+      /**
+       * The type of the value that leaves the last stage
+       */
+      template <class value_, class... stages_>
+      struct pipeline_output
+      {
+         using type = std::remove_cvref_t<value_>;
+      };
+
+      template <class value_, class stage_, class... stages_>
+      struct pipeline_output<value_, stage_, stages_...>
+      {
+         using type = typename pipeline_output<typename stage_output<value_, stage_>::type,
+                                               stages_...>::type;
+      };
+   } // namespace detail
+
+   /**
+    * A chain of operations over a maybe, a result or an either that is evaluated only once it is
+    * run. The stages are fused into a single call: the state of the source is checked once, the
+    * value is threaded through the stages by reference or by move, and only the final monad is
+    * built. A stage returning a monad (and_then) is the only point where the chain may stop early
+    */
+   template <class source_, class... stages_>
+   class pipeline
+   {
+      using traits = detail::pipe_traits<std::remove_cvref_t<source_>>;
+      using source_value = decltype(traits::value(std::declval<source_>()));
+
+   public:
+      using value_type = typename detail::pipeline_output<source_value, stages_...>::type;
+      using output_type = typename traits::template rebind<value_type>;
+
+      constexpr pipeline(source_&& source, std::tuple<stages_...>&& stages) :
+         m_source{std::forward<source_>(source)}, m_stages{std::move(stages)}
+      {}
+
+      /**
+       * Append a stage to the pipeline
+       */
+      template <class stage_>
+         requires detail::is_pipe_stage<std::remove_cvref_t<stage_>>
+      friend constexpr auto operator|(pipeline&& p, stage_&& stage)
+         -> pipeline<source_, stages_..., std::remove_cvref_t<stage_>>
+      {
+         return {std::forward<source_>(p.m_source),
+                 std::tuple_cat(std::move(p.m_stages),
+                                std::tuple<std::remove_cvref_t<stage_>>{
+                                   std::forward<stage_>(stage)})};
+      }
+
+      /**
+       * Evaluate the pipeline, returning the stored value or a specified value if any stage
+       * came up empty
+       */
+      template <class any_>
+      friend constexpr auto operator|(pipeline&& p, detail::value_or_stage<any_>&& stage)
+         -> value_type
+      {
+         return std::move(p).template evaluate<value_type>(
+            [](auto&& value) -> value_type {
+               return std::forward<decltype(value)>(value);
+            },
+            [&](auto&&) -> value_type {
+               return static_cast<value_type>(std::move(stage.value));
+            });
+      }
+
+      /**
+       * Evaluate the pipeline, building only the final monad
+       */
+      constexpr auto run() && -> output_type
+      {
+         return std::move(*this).template evaluate<output_type>(
+            [](auto&& value) -> output_type {
+               return traits::success(value_type(std::forward<decltype(value)>(value)));
+            },
+            [](auto&& failed) -> output_type {
+               using failed_traits = detail::pipe_traits<std::remove_cvref_t<decltype(failed)>>;
+
+               return failed_traits::template failure<value_type>(
+                  std::forward<decltype(failed)>(failed));
+            });
+      }
+      constexpr operator output_type() && { return std::move(*this).run(); }
+
+   private:
+      template <class out_>
+      constexpr auto evaluate(auto&& on_value, auto&& on_failure) && -> out_
+      {
+         if (!traits::has_value(m_source))
+         {
+            return on_failure(std::forward<source_>(m_source));
+         }
+
+         return step<0, out_>(traits::value(std::forward<source_>(m_source)), on_value,
+                              on_failure);
+      }
+
+      template <std::size_t index_, class out_>
+      constexpr auto step(auto&& value, auto& on_value, auto& on_failure) -> out_
+      {
+         if constexpr (index_ == sizeof...(stages_))
+         {
+            return on_value(std::forward<decltype(value)>(value));
+         }
+         else
+         {
+            const auto& stage = std::get<index_>(m_stages);
+
+            if constexpr (detail::is_and_then_stage<std::remove_cvref_t<decltype(stage)>>)
+            {
+               auto next = std::invoke(stage.fun, std::forward<decltype(value)>(value));
+
+               using next_traits = detail::pipe_traits<decltype(next)>;
+
+               if (!next_traits::has_value(next))
+               {
+                  return on_failure(std::move(next));
+               }
+
+               return step<index_ + 1, out_>(next_traits::value(std::move(next)), on_value,
+                                             on_failure);
+            }
+            else
+            {
+               return step<index_ + 1, out_>(
+                  std::invoke(stage.fun, std::forward<decltype(value)>(value)), on_value,
+                  on_failure);
+            }
+         }
+      }
+
+   private:
+      source_ m_source;
+      std::tuple<stages_...> m_stages;
+   };
+
+   /**
+    * Start a lazy pipeline over a maybe, a result or an either. An lvalue source is borrowed and
+    * must outlive the pipeline, an rvalue source is moved into it
+    */
+   template <class monad_>
+   constexpr auto pipe(monad_&& source) -> pipeline<monad_>
+   {
+      return {std::forward<monad_>(source), std::tuple<>{}};
+   }
+
+   /**
+    * Pipeline stage transforming the value
+    */
+   template <class fun_>
+   constexpr auto map(fun_&& fun) -> detail::map_stage<std::decay_t<fun_>>
+   {
+      return {std::forward<fun_>(fun)};
+   }
+
+   /**
+    * Pipeline stage transforming the value into another monad of the same kind
+    */
+   template <class fun_>
+   constexpr auto and_then(fun_&& fun) -> detail::and_then_stage<std::decay_t<fun_>>
+   {
+      return {std::forward<fun_>(fun)};
+   }
+
+   /**
+    * Final pipeline stage returning the value or a specified value
+    */
+   template <class any_>
+   constexpr auto value_or(any_&& value) -> detail::value_or_stage<std::decay_t<any_>>
+   {
+      return {std::forward<any_>(value)};
+   }
+
+   MONADS_ABI_END
+} // namespace monad
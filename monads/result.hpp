@@ -1,9 +1,15 @@
 #pragma once
 
+#include <monads/abi.hpp>
+#include <monads/context.hpp>
 #include <monads/either.hpp>
+#include <monads/instrument.hpp>
+#include <monads/likelihood.hpp>
 
 namespace monad
 {
+   MONADS_ABI_BEGIN
+
    // clang-format off
    template <class value_, class error_>
       requires (!(std::is_reference_v<value_> || std::is_reference_v<error_>))
@@ -12,6 +18,41 @@ namespace monad
 
    namespace detail
    {
+      /**
+       * An error passed through a combinator unchanged. The result is built from it in a
+       * conversion that is out of line and cold unless failures are the likely case, keeping the
+       * copy or move of the error out of the success path. Trivially copyable errors of at most
+       * two words are copied inline: calling out for them costs more than the copy, and taking
+       * their address forces them onto the stack
+       */
+      template <class error_ref_>
+      struct forwarded_error
+      {
+         error_ref_&& error;
+
+         // clang-format off
+         template <class value_, class error_>
+            requires std::is_trivially_copyable_v<std::remove_cvref_t<error_ref_>> &&
+               (sizeof(std::remove_cvref_t<error_ref_>) <= 2 * sizeof(void*))
+         constexpr operator result<value_, error_>() const
+         // clang-format on
+         {
+            return {std::in_place_index<1>, std::forward<error_ref_>(error)};
+         }
+
+         template <class value_, class error_>
+         MONADS_COLD constexpr operator result<value_, error_>() const
+         {
+            return {std::in_place_index<1>, keep_allocator(std::forward<error_ref_>(error))};
+         }
+      };
+
+      template <class any_>
+      constexpr auto forward_error(any_&& error) noexcept -> forwarded_error<any_>
+      {
+         return {std::forward<any_>(error)};
+      }
+
       template <class in_value_, class in_error_>
       constexpr auto ensure_result_error(const result<in_value_, in_error_>& e, in_error_)
          -> result<in_value_, in_error_>
@@ -37,6 +78,12 @@ namespace monad
       {
          return e;
       }
+
+      template <class in_error_>
+      constexpr auto ensure_result_void(const result<void, in_error_>& e) -> result<void, in_error_>
+      {
+         return e;
+      }
    } // namespace detail
 
    template <class any_>
@@ -51,15 +98,26 @@ namespace monad
       any_ value;
    };
 
+   /**
+    * The value of a result<void, E>, which carries no payload
+    */
+   template <>
+   struct value_t<void>
+   {
+   };
+
    template <class any_>
    constexpr auto make_value(any_&& value) -> value_t<std::decay_t<any_>>
    {
       return value_t<std::decay_t<any_>>{std::forward<any_>(value)};
    }
+   constexpr auto make_value() noexcept -> value_t<void> { return {}; }
 
    template <class any_>
-   constexpr auto make_error(any_&& value) -> error_t<std::decay_t<any_>>
+   constexpr auto make_error(any_&& value MONADS_CALL_SITE) -> error_t<std::decay_t<any_>>
    {
+      MONADS_RECORD_ERROR(made, std::decay_t<any_>);
+
       return error_t<std::decay_t<any_>>{std::forward<any_>(value)};
    }
 
@@ -69,7 +127,7 @@ namespace monad
    class result
    // clang-format on
    {
-      template <class first_, class second_, class dummy_ = void>
+      template <class first_, class second_>
       class storage
       {
       public:
@@ -77,33 +135,25 @@ namespace monad
          using error_type = second_;
 
       private:
-         using storage_type =
-            std::array<std::byte, detail::max(sizeof(value_type), sizeof(error_type))>;
-
          // clang-format off
          static inline constexpr bool is_nothrow_default_constructible =
-            std::is_nothrow_default_constructible_v<value_type> && 
-            std::is_nothrow_default_constructible_v<storage_type>;
+            std::is_nothrow_default_constructible_v<value_type>;
 
          static inline constexpr bool is_nothrow_copy_value_constructible =
             std::is_nothrow_copy_assignable_v<value_type> &&
-            std::is_nothrow_copy_constructible_v<value_type> && 
-            std::is_nothrow_default_constructible_v<storage_type>;
+            std::is_nothrow_copy_constructible_v<value_type>;
 
          static inline constexpr bool is_nothrow_move_value_constructible =
             std::is_nothrow_move_assignable_v<value_type> &&
-            std::is_nothrow_move_constructible_v<value_type> &&
-            std::is_nothrow_default_constructible_v<storage_type>;
+            std::is_nothrow_move_constructible_v<value_type>;
 
          static inline constexpr bool is_nothrow_copy_error_constructible =
             std::is_nothrow_copy_assignable_v<error_type> &&
-            std::is_nothrow_copy_constructible_v<error_type> && 
-            std::is_nothrow_default_constructible_v<storage_type>;
+            std::is_nothrow_copy_constructible_v<error_type>;
 
          static inline constexpr bool is_nothrow_move_error_constructible = 
             std::is_nothrow_move_assignable_v<error_type> &&
-            std::is_nothrow_move_constructible_v<error_type> &&
-            std::is_nothrow_default_constructible_v<storage_type>;
+            std::is_nothrow_move_constructible_v<error_type>;
 
          static inline constexpr bool is_nothrow_copy_constructible =
             is_nothrow_copy_value_constructible && 
@@ -115,8 +165,7 @@ namespace monad
 
          static inline constexpr bool is_nothrow_destructible = 
             std::is_nothrow_destructible_v<value_type> &&
-            std::is_nothrow_destructible_v<error_type> &&
-            std::is_nothrow_destructible_v<storage_type>;
+            std::is_nothrow_destructible_v<error_type>;
 
          static inline constexpr bool is_nothrow_copy_assignable =
             is_nothrow_copy_constructible &&
@@ -141,121 +190,134 @@ namespace monad
          static inline constexpr bool is_nothrow_error_value_movable =
             std::is_nothrow_move_assignable_v<error_type> &&
             std::is_nothrow_move_constructible_v<error_type>;
+
+         static inline constexpr bool is_trivially_copy_constructible =
+            trivially_copy_constructible<value_type> &&
+            trivially_copy_constructible<error_type>;
+
+         static inline constexpr bool is_trivially_move_constructible =
+            trivially_move_constructible<value_type> &&
+            trivially_move_constructible<error_type>;
+
+         static inline constexpr bool is_trivially_destructible =
+            trivially_destructible<value_type> &&
+            trivially_destructible<error_type>;
+
+         static inline constexpr bool is_trivially_copy_assignable =
+            trivially_copy_assignable<value_type> &&
+            trivially_copy_assignable<error_type>;
+
+         static inline constexpr bool is_trivially_move_assignable =
+            trivially_move_assignable<value_type> &&
+            trivially_move_assignable<error_type>;
          // clang-format on
 
       public:
-         constexpr storage() noexcept(is_nothrow_default_constructible)
-         {
-            std::construct_at(std::addressof(value()), value_type{});
-         };
-         constexpr storage(const value_t<value_type>& l) noexcept(
-            is_nothrow_copy_value_constructible)
-         {
-            std::construct_at(std::addressof(value()), l.value);
-         }
-         constexpr storage(value_t<value_type>&& l) noexcept(is_nothrow_move_value_constructible)
-         {
-            std::construct_at(std::addressof(value()), std::move(l.value));
-         }
-         constexpr storage(const error_t<error_type>& r) noexcept(
+         constexpr storage() noexcept(is_nothrow_default_constructible) :
+            m_value()
+         {}
+         constexpr storage(const value_t<value_type>& v) noexcept(
+            is_nothrow_copy_value_constructible) :
+            m_value(v.value)
+         {}
+         constexpr storage(value_t<value_type>&& v) noexcept(is_nothrow_move_value_constructible) :
+            m_value(std::move(v.value))
+         {}
+         constexpr storage(const error_t<error_type>& e) noexcept(
             is_nothrow_copy_error_constructible) :
+            m_error(e.value),
             m_is_error{true}
-         {
-            std::construct_at(std::addressof(error()), r.value);
-         }
-         constexpr storage(error_t<error_type>&& r) noexcept(is_nothrow_move_error_constructible) :
+         {}
+         constexpr storage(error_t<error_type>&& e) noexcept(is_nothrow_move_error_constructible) :
+            m_error(std::move(e.value)),
             m_is_error{true}
-         {
-            std::construct_at(std::addressof(error()), std::move(r.value));
-         }
+         {}
+         constexpr storage(std::in_place_index_t<0>, auto&&... args) noexcept(
+            std::is_nothrow_constructible_v<value_type, decltype(args)...>) :
+            m_value(std::forward<decltype(args)>(args)...)
+         {}
+         constexpr storage(std::in_place_index_t<1>, auto&&... args) noexcept(
+            std::is_nothrow_constructible_v<error_type, decltype(args)...>) :
+            m_error(std::forward<decltype(args)>(args)...),
+            m_is_error{true}
+         {}
+         constexpr storage(detail::from_invoke_t<0>, auto&& fun, auto&&... args) :
+            m_value(std::invoke(std::forward<decltype(fun)>(fun),
+                                 std::forward<decltype(args)>(args)...))
+         {}
+         constexpr storage(detail::from_invoke_t<1>, auto&& fun, auto&&... args) :
+            m_error(std::invoke(std::forward<decltype(fun)>(fun),
+                                 std::forward<decltype(args)>(args)...)),
+            m_is_error{true}
+         {}
+         constexpr storage(const storage&) requires is_trivially_copy_constructible = default;
          constexpr storage(const storage& rhs) noexcept(is_nothrow_copy_constructible) :
             m_is_error{rhs.m_is_error}
          {
-            if (is_value())
-            {
-               std::construct_at(std::addressof(value()), rhs.value());
-            }
-            else
-            {
-               std::construct_at(std::addressof(error()()), rhs.error());
-            }
+            construct_from(rhs);
          }
+         constexpr storage(storage&&) requires is_trivially_move_constructible = default;
          constexpr storage(storage&& rhs) noexcept(is_nothrow_move_constructible) :
             m_is_error{rhs.m_is_error}
          {
-            if (is_value())
-            {
-               std::construct_at(std::addressof(value()), std::move(rhs.value()));
-            }
-            else
-            {
-               std::construct_at(std::addressof(error()), std::move(rhs.error()));
-            }
-
-            rhs.m_is_error = false;
+            construct_from(std::move(rhs));
          }
-         ~storage() noexcept(is_nothrow_destructible)
+         constexpr storage(std::allocator_arg_t, const auto& allocator, const storage& rhs) :
+            m_is_error{rhs.m_is_error}
          {
-            if (is_value())
-            {
-               std::destroy_at(std::addressof(value()));
-            }
-            else
-            {
-               std::destroy_at(std::addressof(error()));
-            }
+            construct_from(allocator, rhs);
          }
-
-         constexpr auto operator=(const storage& rhs) -> storage&
+         constexpr storage(std::allocator_arg_t, const auto& allocator, storage&& rhs) :
+            m_is_error{rhs.m_is_error}
+         {
+            construct_from(allocator, std::move(rhs));
+         }
+         ~storage() requires is_trivially_destructible = default;
+         constexpr ~storage() noexcept(is_nothrow_destructible) { destroy(); }
+
+         constexpr auto operator=(const storage&) -> storage& requires
+            detail::copy_replaceable<value_type, error_type> && is_trivially_copy_assignable =
+               default;
+         /**
+          * Copy the content of rhs through emplace, so that a copy which throws leaves the current
+          * content untouched
+          */
+         constexpr auto operator=(const storage& rhs) noexcept(is_nothrow_copy_assignable)
+            -> storage& requires detail::copy_replaceable<value_type, error_type>
          {
             if (this != &rhs)
             {
-               if (is_value())
+               if (rhs.is_value())
                {
-                  std::destroy_at(std::addressof(value()));
+                  emplace_value(rhs.value());
                }
                else
                {
-                  std::destroy_at(std::addressof(error()));
-               }
-
-               m_is_error = rhs.m_is_error;
-
-               if (is_value())
-               {
-                  std::construct_at(std::addressof(value()), rhs.value());
-               }
-               else
-               {
-                  std::construct_at(std::addressof(error()), rhs.error());
+                  emplace_error(rhs.error());
                }
             }
 
             return *this;
          }
-         constexpr auto operator=(storage&& rhs) noexcept(is_nothrow_move_assignable) -> storage&
+         constexpr auto operator=(storage&&) -> storage& requires
+            detail::move_replaceable<value_type, error_type> && is_trivially_move_assignable =
+               default;
+         /**
+          * Move the content of rhs in through emplace, both payloads must be nothrow move
+          * constructible. Payloads whose move may throw are assigned through the copy assignment
+          */
+         constexpr auto operator=(storage&& rhs) noexcept(is_nothrow_move_assignable)
+            -> storage& requires detail::move_replaceable<value_type, error_type>
          {
             if (this != &rhs)
             {
-               if (is_value())
-               {
-                  std::destroy_at(std::addressof(value()));
-               }
-               else
-               {
-                  std::destroy_at(std::addressof(error()));
-               }
-
-               m_is_error = rhs.m_is_error;
-               rhs.m_is_error = false;
-
-               if (is_value())
+               if (rhs.is_value())
                {
-                  std::construct_at(std::addressof(value()), rhs.value());
+                  emplace_value(std::move(rhs.value()));
                }
                else
                {
-                  std::construct_at(std::addressof(error()), rhs.error());
+                  emplace_error(std::move(rhs.error()));
                }
             }
 
@@ -296,99 +358,123 @@ namespace monad
             return std::move(*e_pointer());
          }
 
-      private:
-         constexpr auto v_pointer() noexcept -> value_type*
-         {
-            return reinterpret_cast<value_type*>(m_bytes.data()); // NOLINT
-         }
-         constexpr auto v_pointer() const noexcept -> const value_type*
+         constexpr auto emplace_value(auto&&... args) -> value_type&
          {
-            return reinterpret_cast<const value_type*>(m_bytes.data()); // NOLINT
-         }
+            if constexpr (std::is_nothrow_constructible_v<value_type, decltype(args)...>)
+            {
+               destroy();
+               std::construct_at(v_pointer(), std::forward<decltype(args)>(args)...);
+            }
+            else
+            {
+               value_type temporary(std::forward<decltype(args)>(args)...);
 
-         constexpr auto e_pointer() noexcept -> error_type*
-         {
-            return reinterpret_cast<error_type*>(m_bytes.data()); // NOLINT
+               destroy();
+               std::construct_at(v_pointer(), std::move(temporary));
+            }
+
+            m_is_error = false;
+
+            return *v_pointer();
          }
-         constexpr auto e_pointer() const noexcept -> const error_type*
+         constexpr auto emplace_error(auto&&... args) -> error_type&
          {
-            return reinterpret_cast<const error_type*>(m_bytes.data()); // NOLINT
-         }
-
-      private:
-         alignas(detail::max(alignof(value_type), alignof(error_type))) storage_type m_bytes{};
-         bool m_is_error{false};
-      };
+            if constexpr (std::is_nothrow_constructible_v<error_type, decltype(args)...>)
+            {
+               destroy();
+               std::construct_at(e_pointer(), std::forward<decltype(args)>(args)...);
+            }
+            else
+            {
+               error_type temporary(std::forward<decltype(args)>(args)...);
 
-      template <class first_, class second_>
-      class storage<first_, second_, std::enable_if_t<trivial<first_> && trivial<second_>>>
-      {
-      public:
-         using value_type = first_;
-         using error_type = second_;
+               destroy();
+               std::construct_at(e_pointer(), std::move(temporary));
+            }
 
-      private:
-         using storage_type =
-            std::array<std::byte, detail::max(sizeof(value_type), sizeof(error_type))>;
+            m_is_error = true;
 
-      public:
-         constexpr storage() noexcept { std::construct_at(std::addressof(value()), value_type{}); };
-         constexpr storage(const value_t<value_type>& l) noexcept
-         {
-            std::construct_at(std::addressof(value()), l.value);
+            return *e_pointer();
          }
-         constexpr storage(value_t<value_type>&& l) noexcept
+
+      private:
+         constexpr void construct_from(const storage& rhs)
          {
-            std::construct_at(std::addressof(value()), std::move(l.value));
+            if (is_value())
+            {
+               std::construct_at(v_pointer(), rhs.value());
+            }
+            else
+            {
+               std::construct_at(e_pointer(), rhs.error());
+            }
          }
-         constexpr storage(const error_t<error_type>& r) noexcept : m_is_error{true}
+         constexpr void construct_from(storage&& rhs)
          {
-            std::construct_at(std::addressof(error()), r.value);
+            if (is_value())
+            {
+               std::construct_at(v_pointer(), std::move(rhs.value()));
+            }
+            else
+            {
+               std::construct_at(e_pointer(), std::move(rhs.error()));
+            }
          }
-         constexpr storage(error_t<error_type>&& r) noexcept : m_is_error{true}
+         constexpr void construct_from(const auto& allocator, const storage& rhs)
          {
-            std::construct_at(std::addressof(error()), std::move(r.value));
+            if (is_value())
+            {
+               std::uninitialized_construct_using_allocator(v_pointer(), allocator, rhs.value());
+            }
+            else
+            {
+               std::uninitialized_construct_using_allocator(e_pointer(), allocator, rhs.error());
+            }
          }
-
-         constexpr auto value() & noexcept -> value_type& { return *v_pointer(); }
-         constexpr auto value() const& noexcept -> const value_type& { return *v_pointer(); }
-         constexpr auto value() && noexcept -> value_type&& { return std::move(*v_pointer()); }
-         constexpr auto value() const&& noexcept -> const value_type&&
+         constexpr void construct_from(const auto& allocator, storage&& rhs)
          {
-            return std::move(*v_pointer());
+            if (is_value())
+            {
+               std::uninitialized_construct_using_allocator(v_pointer(), allocator,
+                                                            std::move(rhs.value()));
+            }
+            else
+            {
+               std::uninitialized_construct_using_allocator(e_pointer(), allocator,
+                                                            std::move(rhs.error()));
+            }
          }
 
-         constexpr auto error() & noexcept -> error_type& { return *e_pointer(); }
-         constexpr auto error() const& noexcept -> const error_type& { return *e_pointer(); }
-         constexpr auto error() && noexcept -> error_type&& { return std::move(*e_pointer()); }
-         constexpr auto error() const&& noexcept -> const error_type&&
+         constexpr void destroy() noexcept(is_nothrow_destructible)
          {
-            return std::move(*e_pointer());
+            if (is_value())
+            {
+               std::destroy_at(v_pointer());
+            }
+            else
+            {
+               std::destroy_at(e_pointer());
+            }
          }
 
-         [[nodiscard]] constexpr auto is_value() const noexcept -> bool { return !m_is_error; };
-
-      private:
-         constexpr auto v_pointer() noexcept -> value_type*
-         {
-            return reinterpret_cast<value_type*>(m_bytes.data()); // NOLINT
-         }
+         constexpr auto v_pointer() noexcept -> value_type* { return std::addressof(m_value); }
          constexpr auto v_pointer() const noexcept -> const value_type*
          {
-            return reinterpret_cast<const value_type*>(m_bytes.data()); // NOLINT
+            return std::addressof(m_value);
          }
 
-         constexpr auto e_pointer() noexcept -> error_type*
-         {
-            return reinterpret_cast<error_type*>(m_bytes.data()); // NOLINT
-         }
+         constexpr auto e_pointer() noexcept -> error_type* { return std::addressof(m_error); }
          constexpr auto e_pointer() const noexcept -> const error_type*
          {
-            return reinterpret_cast<const error_type*>(m_bytes.data()); // NOLINT
+            return std::addressof(m_error);
          }
 
       private:
-         alignas(detail::max(alignof(value_type), alignof(error_type))) storage_type m_bytes{};
+         union
+         {
+            value_type m_value;
+            error_type m_error;
+         };
          bool m_is_error{false};
       };
 
@@ -423,6 +509,8 @@ namespace monad
       template <class value_fun, class error_fun>
       using join_result = std::common_type_t<map_value_type<value_fun>, map_error_type<error_fun>>;
 
+      using context_result = result<value_type, detail::contextual_error_t<error_type>>;
+
    public:
       constexpr result(const value_t<value_type>& value) noexcept(
          is_nothrow_value_copy_constructible) :
@@ -433,139 +521,305 @@ namespace monad
       {}
       constexpr result(const error_t<error_type>& error) : m_storage{error} {}
       constexpr result(error_t<error_type>&& error) : m_storage{std::move(error)} {}
+      /**
+       * Construct the value in place from the arguments, without an intermediate value_t
+       */
+      constexpr result(std::in_place_index_t<0> tag, auto&&... args) noexcept(
+         std::is_nothrow_constructible_v<value_type, decltype(args)...>)
+         requires std::constructible_from<value_type, decltype(args)...> :
+         m_storage{tag, std::forward<decltype(args)>(args)...}
+      {}
+      /**
+       * Construct the value in place from the arguments, without an intermediate value_t
+       */
+      constexpr result(std::in_place_type_t<value_type>, auto&&... args) noexcept(
+         std::is_nothrow_constructible_v<value_type, decltype(args)...>)
+         requires(!std::is_same_v<value_type, error_type>) &&
+         std::constructible_from<value_type, decltype(args)...> :
+         m_storage{std::in_place_index<0>, std::forward<decltype(args)>(args)...}
+      {}
+      /**
+       * Construct the error in place from the arguments, without an intermediate error_t
+       */
+      constexpr result(std::in_place_index_t<1> tag, auto&&... args) noexcept(
+         std::is_nothrow_constructible_v<error_type, decltype(args)...>)
+         requires std::constructible_from<error_type, decltype(args)...> :
+         m_storage{tag, std::forward<decltype(args)>(args)...}
+      {}
+      /**
+       * Construct the error in place from the arguments, without an intermediate error_t
+       */
+      constexpr result(std::in_place_type_t<error_type>, auto&&... args) noexcept(
+         std::is_nothrow_constructible_v<error_type, decltype(args)...>)
+         requires(!std::is_same_v<value_type, error_type>) &&
+         std::constructible_from<error_type, decltype(args)...> :
+         m_storage{std::in_place_index<1>, std::forward<decltype(args)>(args)...}
+      {}
+
+      /**
+       * Allocator-extended constructors, the payload is built with uses-allocator construction
+       */
+      constexpr result(std::allocator_arg_t, const auto& allocator,
+                       const value_t<value_type>& value) :
+         m_storage{detail::from_invoke<0>, detail::construct_using_allocator<value_type>, allocator,
+                   value.value}
+      {}
+      constexpr result(std::allocator_arg_t, const auto& allocator, value_t<value_type>&& value) :
+         m_storage{detail::from_invoke<0>, detail::construct_using_allocator<value_type>, allocator,
+                   std::move(value.value)}
+      {}
+      constexpr result(std::allocator_arg_t, const auto& allocator,
+                       const error_t<error_type>& error) :
+         m_storage{detail::from_invoke<1>, detail::construct_using_allocator<error_type>, allocator,
+                   error.value}
+      {}
+      constexpr result(std::allocator_arg_t, const auto& allocator, error_t<error_type>&& error) :
+         m_storage{detail::from_invoke<1>, detail::construct_using_allocator<error_type>, allocator,
+                   std::move(error.value)}
+      {}
+      constexpr result(std::allocator_arg_t, const auto& allocator, std::in_place_index_t<0>,
+                       auto&&... args)
+         requires std::constructible_from<value_type, decltype(args)...> :
+         m_storage{detail::from_invoke<0>, detail::construct_using_allocator<value_type>, allocator,
+                   std::forward<decltype(args)>(args)...}
+      {}
+      constexpr result(std::allocator_arg_t, const auto& allocator, std::in_place_index_t<1>,
+                       auto&&... args)
+         requires std::constructible_from<error_type, decltype(args)...> :
+         m_storage{detail::from_invoke<1>, detail::construct_using_allocator<error_type>, allocator,
+                   std::forward<decltype(args)>(args)...}
+      {}
+      constexpr result(std::allocator_arg_t tag, const auto& allocator, const result& other) :
+         m_storage{tag, allocator, other.m_storage}
+      {}
+      constexpr result(std::allocator_arg_t tag, const auto& allocator, result&& other) :
+         m_storage{tag, allocator, std::move(other.m_storage)}
+      {}
 
       [[nodiscard]] constexpr auto is_value() const -> bool { return m_storage.is_value(); }
       constexpr operator bool() const { return is_value(); }
 
-      constexpr auto value() const& -> maybe<value_type> requires copyable
+      constexpr auto value() const& -> maybe<value_type> requires std::copyable<value_type>
       {
-         return is_value() ? make_maybe(m_storage.value()) : none;
+         return is_value() ? make_maybe(detail::keep_allocator(m_storage.value())) : none;
       }
-      constexpr auto value() & -> maybe<value_type> requires copyable
+      constexpr auto value() & -> maybe<value_type> requires std::copyable<value_type>
       {
-         return is_value() ? make_maybe(m_storage.value()) : none;
+         return is_value() ? make_maybe(detail::keep_allocator(m_storage.value())) : none;
       }
-      constexpr auto value() const&& -> maybe<value_type> requires movable
+      constexpr auto value() const&& -> maybe<value_type> requires std::movable<value_type>
       {
          return is_value() ? make_maybe(std::move(m_storage.value())) : none;
       }
-      constexpr auto value() && -> maybe<value_type> requires movable
+      constexpr auto value() && -> maybe<value_type> requires std::movable<value_type>
       {
          return is_value() ? make_maybe(std::move(m_storage.value())) : none;
       }
 
-      constexpr auto error() const& -> maybe<error_type> requires copyable
+      constexpr auto error() const& -> maybe<error_type> requires std::copyable<error_type>
       {
-         return is_value() ? none : make_maybe(m_storage.error());
+         return is_value() ? none : make_maybe(detail::keep_allocator(m_storage.error()));
       }
-      constexpr auto error() & -> maybe<error_type> requires copyable
+      constexpr auto error() & -> maybe<error_type> requires std::copyable<error_type>
       {
-         return is_value() ? none : make_maybe(m_storage.error());
+         return is_value() ? none : make_maybe(detail::keep_allocator(m_storage.error()));
       }
-      constexpr auto error() const&& -> maybe<error_type> requires movable
+      constexpr auto error() const&& -> maybe<error_type> requires std::movable<error_type>
       {
          return is_value() ? none : make_maybe(std::move(m_storage.error()));
       }
-      constexpr auto error() && -> maybe<error_type> requires movable
+      constexpr auto error() && -> maybe<error_type> requires std::movable<error_type>
       {
          return is_value() ? none : make_maybe(std::move(m_storage.error()));
       }
 
+      /**
+       * Access the stored value without copying it, returns nullptr if an error is stored
+       */
+      constexpr auto value_ptr() noexcept -> value_type*
+      {
+         return is_value() ? std::addressof(m_storage.value()) : nullptr;
+      }
+      /**
+       * Access the stored value without copying it, returns nullptr if an error is stored
+       */
+      constexpr auto value_ptr() const noexcept -> const value_type*
+      {
+         return is_value() ? std::addressof(m_storage.value()) : nullptr;
+      }
+
+      /**
+       * Access the stored error without copying it, returns nullptr if a value is stored
+       */
+      constexpr auto error_ptr() noexcept -> error_type*
+      {
+         return is_value() ? nullptr : std::addressof(m_storage.error());
+      }
+      /**
+       * Access the stored error without copying it, returns nullptr if a value is stored
+       */
+      constexpr auto error_ptr() const noexcept -> const error_type*
+      {
+         return is_value() ? nullptr : std::addressof(m_storage.error());
+      }
+
+      /**
+       * Destroy the current content and construct the value in place from the arguments. If the
+       * construction may throw, the value is built first and moved in, which must not throw, so
+       * that the current content survives a failed construction
+       */
+      constexpr auto emplace_value(auto&&... args) -> value_type& requires
+         std::constructible_from<value_type, decltype(args)...> &&
+         (std::is_nothrow_constructible_v<value_type, decltype(args)...> ||
+          std::is_nothrow_move_constructible_v<value_type>)
+      {
+         return m_storage.emplace_value(std::forward<decltype(args)>(args)...);
+      }
+
+      /**
+       * Destroy the current content and construct the error in place from the arguments. If the
+       * construction may throw, the error is built first and moved in, which must not throw, so
+       * that the current content survives a failed construction
+       */
+      constexpr auto emplace_error(auto&&... args) -> error_type& requires
+         std::constructible_from<error_type, decltype(args)...> &&
+         (std::is_nothrow_constructible_v<error_type, decltype(args)...> ||
+          std::is_nothrow_move_constructible_v<error_type>)
+      {
+         return m_storage.emplace_error(std::forward<decltype(args)>(args)...);
+      }
+
       constexpr auto
       map(const std::invocable<value_type> auto& fun) const& -> map_value_result<decltype(fun)>
       {
-         if (is_value())
+         if (is_value()) MONADS_SUCCESS_BRANCH
          {
-            return make_value(std::invoke(fun, m_storage.value()));
+            return {detail::from_invoke<0>, fun, m_storage.value()};
          }
-         else
+         else MONADS_FAILURE_BRANCH
          {
-            return make_error(m_storage.error());
+            return detail::forward_error(m_storage.error());
          }
       }
       constexpr auto
       map(const std::invocable<value_type> auto& fun) & -> map_value_result<decltype(fun)>
       {
-         if (is_value())
+         if (is_value()) MONADS_SUCCESS_BRANCH
          {
-            return make_value(std::invoke(fun, m_storage.value()));
+            return {detail::from_invoke<0>, fun, m_storage.value()};
          }
-         else
+         else MONADS_FAILURE_BRANCH
          {
-            return make_error(m_storage.error());
+            return detail::forward_error(m_storage.error());
          }
       }
       constexpr auto
       map(const std::invocable<value_type> auto& fun) const&& -> map_value_result<decltype(fun)>
       {
-         if (is_value())
+         if (is_value()) MONADS_SUCCESS_BRANCH
          {
-            return make_value(std::invoke(fun, std::move(m_storage.value())));
+            return {detail::from_invoke<0>, fun, std::move(m_storage.value())};
          }
-         else
+         else MONADS_FAILURE_BRANCH
          {
-            return make_error(std::move(m_storage.error()));
+            return detail::forward_error(std::move(m_storage.error()));
          }
       }
       constexpr auto
       map(const std::invocable<value_type> auto& fun) && -> map_value_result<decltype(fun)>
       {
-         if (is_value())
+         if (is_value()) MONADS_SUCCESS_BRANCH
          {
-            return make_value(std::invoke(fun, std::move(m_storage.value())));
+            return {detail::from_invoke<0>, fun, std::move(m_storage.value())};
          }
-         else
+         else MONADS_FAILURE_BRANCH
          {
-            return make_error(std::move(m_storage.error()));
+            return detail::forward_error(std::move(m_storage.error()));
          }
       }
 
       constexpr auto map_error(
          const std::invocable<error_type> auto& fun) const& -> map_error_result<decltype(fun)>
       {
-         if (is_value())
+         if (is_value()) MONADS_SUCCESS_BRANCH
          {
-            return make_value(m_storage.value());
+            return {std::in_place_index<0>, detail::keep_allocator(m_storage.value())};
          }
-         else
+         else MONADS_FAILURE_BRANCH
          {
-            return make_error(std::invoke(fun, m_storage.error()));
+            return {detail::from_invoke<1>, fun, m_storage.error()};
          }
       }
       constexpr auto
       map_error(const std::invocable<error_type> auto& fun) & -> map_error_result<decltype(fun)>
       {
-         if (is_value())
+         if (is_value()) MONADS_SUCCESS_BRANCH
          {
-            return make_value(m_storage.value());
+            return {std::in_place_index<0>, detail::keep_allocator(m_storage.value())};
          }
-         else
+         else MONADS_FAILURE_BRANCH
          {
-            return make_error(std::invoke(fun, m_storage.error()));
+            return {detail::from_invoke<1>, fun, m_storage.error()};
          }
       }
       constexpr auto map_error(
          const std::invocable<error_type> auto& fun) const&& -> map_error_result<decltype(fun)>
       {
-         if (is_value())
+         if (is_value()) MONADS_SUCCESS_BRANCH
          {
-            return make_value(std::move(m_storage.value()));
+            return {std::in_place_index<0>, std::move(m_storage.value())};
          }
-         else
+         else MONADS_FAILURE_BRANCH
          {
-            return make_error(std::invoke(fun, std::move(m_storage.error())));
+            return {detail::from_invoke<1>, fun, std::move(m_storage.error())};
          }
       }
       constexpr auto
       map_error(const std::invocable<error_type> auto& fun) && -> map_error_result<decltype(fun)>
       {
-         if (is_value())
+         if (is_value()) MONADS_SUCCESS_BRANCH
+         {
+            return {std::in_place_index<0>, std::move(m_storage.value())};
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            return {detail::from_invoke<1>, fun, std::move(m_storage.error())};
+         }
+      }
+
+      /**
+       * Attach a frame to the error, made of a description of what was being done and the call
+       * site. The error becomes contextual on the first frame. On success nothing is built
+       */
+      constexpr auto context(const char* what,
+                             const std::source_location& where =
+                                std::source_location::current()) const& -> context_result
+      {
+         if (is_value()) MONADS_SUCCESS_BRANCH
+         {
+            return {std::in_place_index<0>, detail::keep_allocator(m_storage.value())};
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            return detail::attach_context<context_result>(m_storage.error(), {what, where});
+         }
+      }
+      /**
+       * Attach a frame to the error, made of a description of what was being done and the call
+       * site. The error becomes contextual on the first frame. On success nothing is built
+       */
+      constexpr auto context(const char* what,
+                             const std::source_location& where =
+                                std::source_location::current()) && -> context_result
+      {
+         if (is_value()) MONADS_SUCCESS_BRANCH
          {
-            return make_value(std::move(m_storage.value()));
+            return {std::in_place_index<0>, std::move(m_storage.value())};
          }
-         else
+         else MONADS_FAILURE_BRANCH
          {
-            return make_error(std::invoke(fun, std::move(m_storage.error())));
+            return detail::attach_context<context_result>(std::move(m_storage.error()),
+                                                          {what, where});
          }
       }
 
@@ -623,69 +877,93 @@ namespace monad
                            : std::invoke(r_fun, std::move(m_storage.error()));
       }
 
+   private:
+      template <std::size_t index_>
+      constexpr result(detail::from_invoke_t<index_> tag, auto&& fun, auto&&... args) :
+         m_storage{tag, std::forward<decltype(fun)>(fun), std::forward<decltype(args)>(args)...}
+      {}
+
    private:
       storage<value_type, error_type> m_storage{};
 
+      // clang-format off
+      template <class other_value_, class other_error_>
+         requires (!(std::is_reference_v<other_value_> || std::is_reference_v<other_error_>))
+      friend class result;
+      // clang-format on
+
    public:
-      constexpr auto and_then(const std::invocable<value_type> auto& fun) const& -> decltype(
-         detail::ensure_result_error(std::invoke(fun, m_storage.value()), m_storage.error()))
+      constexpr auto and_then(const std::invocable<value_type> auto& fun MONADS_CALL_SITE)
+         const& -> decltype(
+            detail::ensure_result_error(std::invoke(fun, m_storage.value()), m_storage.error()))
       {
-         if (is_value())
+         if (is_value()) MONADS_SUCCESS_BRANCH
          {
             return std::invoke(fun, m_storage.value());
          }
-         else
+         else MONADS_FAILURE_BRANCH
          {
-            return make_error(m_storage.error());
+            MONADS_RECORD_ERROR(propagated, error_type);
+
+            return detail::forward_error(m_storage.error());
          }
       }
-      constexpr auto and_then(const std::invocable<value_type> auto& fun) & -> decltype(
-         detail::ensure_result_error(std::invoke(fun, m_storage.value()), m_storage.error()))
+      constexpr auto and_then(const std::invocable<value_type> auto& fun MONADS_CALL_SITE)
+         & -> decltype(
+            detail::ensure_result_error(std::invoke(fun, m_storage.value()), m_storage.error()))
       {
-         if (is_value())
+         if (is_value()) MONADS_SUCCESS_BRANCH
          {
             return std::invoke(fun, m_storage.value());
          }
-         else
+         else MONADS_FAILURE_BRANCH
          {
-            return make_error(m_storage.error());
+            MONADS_RECORD_ERROR(propagated, error_type);
+
+            return detail::forward_error(m_storage.error());
          }
       }
-      constexpr auto and_then(const std::invocable<value_type> auto& fun) const&& -> decltype(
-         detail::ensure_result_error(std::invoke(fun, std::move(m_storage.value())),
-                                     std::move(m_storage.error())))
+      constexpr auto and_then(const std::invocable<value_type> auto& fun MONADS_CALL_SITE)
+         const&& -> decltype(
+            detail::ensure_result_error(std::invoke(fun, std::move(m_storage.value())),
+                                        std::move(m_storage.error())))
       {
-         if (is_value())
+         if (is_value()) MONADS_SUCCESS_BRANCH
          {
             return std::invoke(fun, std::move(m_storage.value()));
          }
-         else
+         else MONADS_FAILURE_BRANCH
          {
-            return make_error(std::move(m_storage.error()));
+            MONADS_RECORD_ERROR(propagated, error_type);
+
+            return detail::forward_error(std::move(m_storage.error()));
          }
       }
-      constexpr auto and_then(const std::invocable<value_type> auto& fun) && -> decltype(
-         detail::ensure_result_error(std::invoke(fun, std::move(m_storage.value())),
-                                     std::move(m_storage.error())))
+      constexpr auto and_then(const std::invocable<value_type> auto& fun MONADS_CALL_SITE)
+         && -> decltype(
+            detail::ensure_result_error(std::invoke(fun, std::move(m_storage.value())),
+                                        std::move(m_storage.error())))
       {
-         if (is_value())
+         if (is_value()) MONADS_SUCCESS_BRANCH
          {
             return std::invoke(fun, std::move(m_storage.value()));
          }
-         else
+         else MONADS_FAILURE_BRANCH
          {
-            return make_error(std::move(m_storage.error()));
+            MONADS_RECORD_ERROR(propagated, error_type);
+
+            return detail::forward_error(std::move(m_storage.error()));
          }
       }
 
       constexpr auto or_else(const std::invocable<error_type> auto& fun) const& -> decltype(
          detail::ensure_result_value(std::invoke(fun, m_storage.error()), m_storage.value()))
       {
-         if (is_value())
+         if (is_value()) MONADS_SUCCESS_BRANCH
          {
-            return make_value(m_storage.value());
+            return {std::in_place_index<0>, detail::keep_allocator(m_storage.value())};
          }
-         else
+         else MONADS_FAILURE_BRANCH
          {
             return std::invoke(fun, m_storage.error());
          }
@@ -693,11 +971,11 @@ namespace monad
       constexpr auto or_else(const std::invocable<error_type> auto& fun) & -> decltype(
          detail::ensure_result_value(std::invoke(fun, m_storage.error()), m_storage.value()))
       {
-         if (is_value())
+         if (is_value()) MONADS_SUCCESS_BRANCH
          {
-            return make_value(m_storage.value());
+            return {std::in_place_index<0>, detail::keep_allocator(m_storage.value())};
          }
-         else
+         else MONADS_FAILURE_BRANCH
          {
             return std::invoke(fun, m_storage.error());
          }
@@ -706,11 +984,11 @@ namespace monad
          detail::ensure_result_value(std::invoke(fun, std::move(m_storage.error())),
                                      std::move(m_storage.value())))
       {
-         if (is_value())
+         if (is_value()) MONADS_SUCCESS_BRANCH
          {
-            return make_value(std::move(m_storage.value()));
+            return {std::in_place_index<0>, std::move(m_storage.value())};
          }
-         else
+         else MONADS_FAILURE_BRANCH
          {
             return std::invoke(fun, std::move(m_storage.error()));
          }
@@ -719,14 +997,352 @@ namespace monad
          detail::ensure_result_value(std::invoke(fun, std::move(m_storage.error())),
                                      std::move(m_storage.value())))
       {
-         if (is_value())
+         if (is_value()) MONADS_SUCCESS_BRANCH
          {
-            return make_value(std::move(m_storage.value()));
+            return {std::in_place_index<0>, std::move(m_storage.value())};
          }
-         else
+         else MONADS_FAILURE_BRANCH
          {
             return std::invoke(fun, std::move(m_storage.error()));
          }
       }
    };
+
+   /**
+    * A result of an operation that produces no value on success. Only the error is stored, inside
+    * a maybe, so the result is the size of the error plus the engaged flag, or the size of the
+    * error alone when the error type has a niche
+    */
+   template <class error_>
+   class result<void, error_>
+   {
+      template <class fun_>
+      using map_value_result = result<std::invoke_result_t<fun_>, error_>;
+
+      template <class fun_>
+      using map_error_result = result<void, std::invoke_result_t<fun_, error_>>;
+
+      using context_result = result<void, detail::contextual_error_t<error_>>;
+
+   public:
+      using value_type = void;
+      using error_type = error_;
+
+      /**
+       * Construct a successful result
+       */
+      constexpr result() noexcept = default;
+      constexpr result(value_t<void>) noexcept {}
+      constexpr result(std::in_place_index_t<0>) noexcept {}
+      constexpr result(const error_t<error_type>& error) : m_error{error.value} {}
+      constexpr result(error_t<error_type>&& error) : m_error{std::move(error.value)} {}
+      /**
+       * Construct the error in place from the arguments, without an intermediate error_t
+       */
+      template <class... args_>
+         requires std::constructible_from<error_type, args_...>
+      constexpr result(std::in_place_index_t<1>, args_&&... args) noexcept(
+         std::is_nothrow_constructible_v<error_type, args_...>) :
+         m_error{std::in_place, std::forward<args_>(args)...}
+      {}
+
+      /**
+       * Allocator-extended constructors, the error is built with uses-allocator construction
+       */
+      constexpr result(std::allocator_arg_t, const auto&) noexcept {}
+      constexpr result(std::allocator_arg_t, const auto&, value_t<void>) noexcept {}
+      constexpr result(std::allocator_arg_t, const auto&, std::in_place_index_t<0>) noexcept {}
+      constexpr result(std::allocator_arg_t tag, const auto& allocator,
+                       const error_t<error_type>& error) :
+         m_error{tag, allocator, error.value}
+      {}
+      constexpr result(std::allocator_arg_t tag, const auto& allocator,
+                       error_t<error_type>&& error) :
+         m_error{tag, allocator, std::move(error.value)}
+      {}
+      template <class... args_>
+         requires std::constructible_from<error_type, args_...>
+      constexpr result(std::allocator_arg_t tag, const auto& allocator, std::in_place_index_t<1>,
+                       args_&&... args) :
+         m_error{tag, allocator, std::in_place, std::forward<args_>(args)...}
+      {}
+      constexpr result(std::allocator_arg_t tag, const auto& allocator, const result& other) :
+         m_error{tag, allocator, other.m_error}
+      {}
+      constexpr result(std::allocator_arg_t tag, const auto& allocator, result&& other) :
+         m_error{tag, allocator, std::move(other.m_error)}
+      {}
+
+      [[nodiscard]] constexpr auto is_value() const noexcept -> bool { return !m_error; }
+      constexpr operator bool() const noexcept { return is_value(); }
+
+      constexpr auto error() const& -> maybe<error_type> requires std::copyable<error_type>
+      {
+         return is_value() ? none : make_maybe(detail::keep_allocator(*m_error));
+      }
+      constexpr auto error() && -> maybe<error_type> requires std::movable<error_type>
+      {
+         return std::move(m_error);
+      }
+
+      /**
+       * Access the stored error without copying it, returns nullptr on success
+       */
+      constexpr auto error_ptr() noexcept -> error_type*
+      {
+         return is_value() ? nullptr : std::addressof(*m_error);
+      }
+      /**
+       * Access the stored error without copying it, returns nullptr on success
+       */
+      constexpr auto error_ptr() const noexcept -> const error_type*
+      {
+         return is_value() ? nullptr : std::addressof(*m_error);
+      }
+
+      /**
+       * Return the stored error, or a specified error on success
+       */
+      constexpr auto error_or(std::convertible_to<error_type> auto&& default_error) const&
+         -> error_type
+      {
+         return is_value() ? static_cast<error_type>(
+                                std::forward<decltype(default_error)>(default_error))
+                           : detail::keep_allocator(*m_error);
+      }
+      /**
+       * Return the stored error, or a specified error on success
+       */
+      constexpr auto error_or(std::convertible_to<error_type> auto&& default_error) && -> error_type
+      {
+         return is_value() ? static_cast<error_type>(
+                                std::forward<decltype(default_error)>(default_error))
+                           : std::move(*m_error);
+      }
+
+      /**
+       * Clear the error, making the result successful
+       */
+      constexpr void emplace_value() noexcept { m_error.reset(); }
+      /**
+       * Replace the content by an error constructed in place from the arguments. The result is
+       * left successful if the construction throws
+       */
+      template <class... args_>
+         requires std::constructible_from<error_type, args_...>
+      constexpr auto emplace_error(args_&&... args) -> error_type&
+      {
+         return m_error.emplace(std::forward<args_>(args)...);
+      }
+
+      /**
+       * Carries out a nullary operation on success
+       */
+      constexpr auto map(const std::invocable auto& fun) const& -> map_value_result<decltype(fun)>
+      {
+         if (is_value()) MONADS_SUCCESS_BRANCH
+         {
+            return {detail::from_invoke<0>, fun};
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            return detail::forward_error(*m_error);
+         }
+      }
+      /**
+       * Carries out a nullary operation on success
+       */
+      constexpr auto map(const std::invocable auto& fun) && -> map_value_result<decltype(fun)>
+      {
+         if (is_value()) MONADS_SUCCESS_BRANCH
+         {
+            return {detail::from_invoke<0>, fun};
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            return detail::forward_error(std::move(*m_error));
+         }
+      }
+
+      constexpr auto map_error(
+         const std::invocable<error_type> auto& fun) const& -> map_error_result<decltype(fun)>
+      {
+         if (is_value()) MONADS_SUCCESS_BRANCH
+         {
+            return {};
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            return {detail::from_invoke<1>, fun, *m_error};
+         }
+      }
+      constexpr auto
+      map_error(const std::invocable<error_type> auto& fun) && -> map_error_result<decltype(fun)>
+      {
+         if (is_value()) MONADS_SUCCESS_BRANCH
+         {
+            return {};
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            return {detail::from_invoke<1>, fun, std::move(*m_error)};
+         }
+      }
+
+      /**
+       * Attach a frame to the error, made of a description of what was being done and the call
+       * site. The error becomes contextual on the first frame. On success nothing is built
+       */
+      constexpr auto context(const char* what,
+                             const std::source_location& where =
+                                std::source_location::current()) const& -> context_result
+      {
+         if (is_value()) MONADS_SUCCESS_BRANCH
+         {
+            return {};
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            return detail::attach_context<context_result>(*m_error, {what, where});
+         }
+      }
+      /**
+       * Attach a frame to the error, made of a description of what was being done and the call
+       * site. The error becomes contextual on the first frame. On success nothing is built
+       */
+      constexpr auto context(const char* what,
+                             const std::source_location& where =
+                                std::source_location::current()) && -> context_result
+      {
+         if (is_value()) MONADS_SUCCESS_BRANCH
+         {
+            return {};
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            return detail::attach_context<context_result>(std::move(*m_error), {what, where});
+         }
+      }
+
+      /**
+       * Continue with a nullary operation returning a result with the same error type
+       */
+      constexpr auto and_then(const std::invocable auto& fun MONADS_CALL_SITE) const& -> decltype(
+         detail::ensure_result_error(std::invoke(fun), std::declval<const error_type&>()))
+      {
+         if (is_value()) MONADS_SUCCESS_BRANCH
+         {
+            return std::invoke(fun);
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            MONADS_RECORD_ERROR(propagated, error_type);
+
+            return detail::forward_error(*m_error);
+         }
+      }
+      /**
+       * Continue with a nullary operation returning a result with the same error type
+       */
+      constexpr auto and_then(const std::invocable auto& fun MONADS_CALL_SITE) && -> decltype(
+         detail::ensure_result_error(std::invoke(fun), std::declval<error_type>()))
+      {
+         if (is_value()) MONADS_SUCCESS_BRANCH
+         {
+            return std::invoke(fun);
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            MONADS_RECORD_ERROR(propagated, error_type);
+
+            return detail::forward_error(std::move(*m_error));
+         }
+      }
+
+      /**
+       * Recover from the error with an operation returning a result<void, F>
+       */
+      constexpr auto or_else(const std::invocable<error_type> auto& fun) const& -> decltype(
+         detail::ensure_result_void(std::invoke(fun, std::declval<const error_type&>())))
+      {
+         if (is_value()) MONADS_SUCCESS_BRANCH
+         {
+            return {};
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            return std::invoke(fun, *m_error);
+         }
+      }
+      /**
+       * Recover from the error with an operation returning a result<void, F>
+       */
+      constexpr auto or_else(const std::invocable<error_type> auto& fun) && -> decltype(
+         detail::ensure_result_void(std::invoke(fun, std::declval<error_type>())))
+      {
+         if (is_value()) MONADS_SUCCESS_BRANCH
+         {
+            return {};
+         }
+         else MONADS_FAILURE_BRANCH
+         {
+            return std::invoke(fun, std::move(*m_error));
+         }
+      }
+
+      /**
+       * Carries out a nullary operation on success, or returns a specified value
+       */
+      constexpr auto map_or(const std::invocable auto& fun,
+                            std::convertible_to<std::invoke_result_t<decltype(fun)>> auto&& other)
+         const -> std::remove_cvref_t<std::invoke_result_t<decltype(fun)>>
+      {
+         return is_value() ? std::invoke(fun) : std::forward<decltype(other)>(other);
+      }
+
+      constexpr auto join(const std::invocable auto& v_fun,
+                          const std::invocable<error_type> auto& e_fun) const& -> std::
+         common_type_t<std::invoke_result_t<decltype(v_fun)>,
+                       std::invoke_result_t<decltype(e_fun), error_type>>
+      {
+         return is_value() ? std::invoke(v_fun) : std::invoke(e_fun, *m_error);
+      }
+      constexpr auto join(const std::invocable auto& v_fun,
+                          const std::invocable<error_type> auto& e_fun) && -> std::
+         common_type_t<std::invoke_result_t<decltype(v_fun)>,
+                       std::invoke_result_t<decltype(e_fun), error_type>>
+      {
+         return is_value() ? std::invoke(v_fun) : std::invoke(e_fun, std::move(*m_error));
+      }
+
+   private:
+      constexpr result(detail::from_invoke_t<0>, auto&& fun, auto&&... args)
+      {
+         std::invoke(std::forward<decltype(fun)>(fun), std::forward<decltype(args)>(args)...);
+      }
+      constexpr result(detail::from_invoke_t<1>, auto&& fun, auto&&... args) :
+         m_error{
+            std::invoke(std::forward<decltype(fun)>(fun), std::forward<decltype(args)>(args)...)}
+      {}
+
+   private:
+      maybe<error_type> m_error{};
+
+      // clang-format off
+      template <class other_value_, class other_error_>
+         requires (!(std::is_reference_v<other_value_> || std::is_reference_v<other_error_>))
+      friend class result;
+      // clang-format on
+   };
+
+   MONADS_ABI_END
 } // namespace monad
+
+namespace std // NOLINT
+{
+   template <class value_, class error_, class allocator_>
+   struct uses_allocator<monad::result<value_, error_>, allocator_> :
+      bool_constant<uses_allocator_v<value_, allocator_> || uses_allocator_v<error_, allocator_>>
+   {
+   };
+} // namespace std
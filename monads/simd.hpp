@@ -0,0 +1,500 @@
+#pragma once
+
+#include "monads/abi.hpp"
+#include "monads/maybe.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#   define MONADS_SIMD_X86 1
+#else
+#   define MONADS_SIMD_X86 0
+#endif
+
+#if MONADS_SIMD_X86
+#   define MONADS_SIMD_INLINE [[gnu::always_inline]] inline
+#   define MONADS_SIMD_TARGET_AVX2 [[gnu::target("avx2")]]
+#   define MONADS_SIMD_TARGET_AVX512 [[gnu::target("avx512f,avx512bw,avx512vl,avx2")]]
+#else
+#   define MONADS_SIMD_INLINE inline
+#   define MONADS_SIMD_TARGET_AVX2
+#   define MONADS_SIMD_TARGET_AVX512
+#endif
+
+/**
+ * Bulk kernels over contiguous runs of maybe<T>.
+ *
+ * For trivial types whose maybe layout is either a value followed by its engaged flag, or a
+ * value with a niche, the kernels read the run as plain unsigned lanes so that the loops are
+ * branch free and vectorized. They are compiled for SSE2, AVX2 and AVX-512 and the widest
+ * instruction set supported by the CPU is selected at runtime. Other types go through the
+ * scalar maybe interface.
+ */
+namespace monad
+{
+   MONADS_ABI_BEGIN
+
+   namespace simd
+   {
+      enum class isa
+      {
+         scalar,
+         sse2,
+         avx2,
+         avx512
+      };
+
+      /**
+       * Detect the widest instruction set supported by the running CPU
+       */
+      inline auto detect_isa() noexcept -> isa
+      {
+#if MONADS_SIMD_X86
+         __builtin_cpu_init();
+
+         if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+             __builtin_cpu_supports("avx512vl"))
+         {
+            return isa::avx512;
+         }
+
+         if (__builtin_cpu_supports("avx2"))
+         {
+            return isa::avx2;
+         }
+
+         return isa::sse2;
+#else
+         return isa::scalar;
+#endif
+      }
+
+      /**
+       * The instruction set used by the kernels when none is specified, detected once
+       */
+      inline auto active_isa() noexcept -> isa
+      {
+         static const isa target = detect_isa();
+
+         return target;
+      }
+
+      namespace detail
+      {
+         template <class any_>
+         struct maybe_value
+         {
+         };
+
+         template <class any_>
+         struct maybe_value<maybe<any_>>
+         {
+            using type = any_;
+         };
+
+         template <class range_>
+         using maybe_value_t = typename maybe_value<std::ranges::range_value_t<range_>>::type;
+
+         template <class range_>
+         concept maybe_range = std::ranges::contiguous_range<range_> &&
+            std::ranges::sized_range<range_> && requires { typename maybe_value_t<range_>; };
+
+         template <std::size_t size_>
+         struct lane;
+
+#if MONADS_SIMD_X86
+         template <>
+         struct lane<1>
+         {
+            using type = std::uint8_t;
+         };
+
+         template <>
+         struct lane<2>
+         {
+            using type [[gnu::may_alias]] = std::uint16_t;
+         };
+
+         template <>
+         struct lane<4>
+         {
+            using type [[gnu::may_alias]] = std::uint32_t;
+         };
+
+         template <>
+         struct lane<8>
+         {
+            using type [[gnu::may_alias]] = std::uint64_t;
+         };
+#endif
+
+         template <class any_>
+         concept lane_sized = requires { typename lane<sizeof(any_)>::type; } &&
+            alignof(any_) == sizeof(any_) && std::is_standard_layout_v<maybe<any_>>;
+
+         /**
+          * maybe<T> is the value followed by a one byte engaged flag, padded to two lanes
+          */
+         template <class any_>
+         concept flagged_layout = trivial<any_> && !has_niche<any_> && lane_sized<any_> &&
+            sizeof(maybe<any_>) == 2 * sizeof(any_);
+
+         /**
+          * maybe<T> is the value itself, the empty state being the niche sentinel
+          */
+         template <class any_>
+         concept niche_layout = trivial<any_> && value_niche<any_> && has_niche<any_> &&
+            lane_sized<any_> && sizeof(maybe<any_>) == sizeof(any_);
+
+         template <class any_>
+         concept lane_layout = flagged_layout<any_> || niche_layout<any_>;
+
+         template <lane_layout any_>
+         struct lanes
+         {
+            using lane_type = typename lane<sizeof(any_)>::type;
+
+            static constexpr std::size_t stride = flagged_layout<any_> ? 2 : 1;
+
+            MONADS_SIMD_INLINE static auto data(const maybe<any_>* values) noexcept
+               -> const lane_type*
+            {
+               return reinterpret_cast<const lane_type*>(values); // NOLINT
+            }
+            MONADS_SIMD_INLINE static auto data(maybe<any_>* values) noexcept -> lane_type*
+            {
+               return reinterpret_cast<lane_type*>(values); // NOLINT
+            }
+
+            MONADS_SIMD_INLINE static auto engaged(const lane_type* lanes, std::size_t i) noexcept
+               -> bool
+            {
+               if constexpr (flagged_layout<any_>)
+               {
+                  return (lanes[stride * i + 1] & 0xFFU) != 0;
+               }
+               else
+               {
+                  return !niche<any_>::is_none(std::bit_cast<any_>(lanes[i]));
+               }
+            }
+
+            MONADS_SIMD_INLINE static auto value(const lane_type* lanes, std::size_t i) noexcept
+               -> any_
+            {
+               return std::bit_cast<any_>(lanes[stride * i]);
+            }
+
+            MONADS_SIMD_INLINE static void store(lane_type* lanes, std::size_t i, bool engaged,
+                                                 const any_& value) noexcept
+            {
+               if constexpr (flagged_layout<any_>)
+               {
+                  const auto flag = static_cast<lane_type>(engaged);
+                  const auto mask = static_cast<lane_type>(lane_type{0} - flag);
+
+                  lanes[stride * i] =
+                     static_cast<lane_type>(std::bit_cast<lane_type>(value) & mask);
+                  lanes[stride * i + 1] = flag;
+               }
+               else
+               {
+                  lanes[i] = std::bit_cast<lane_type>(engaged ? value : niche<any_>::none());
+               }
+            }
+         };
+
+         struct count_kernel
+         {
+            template <class any_>
+            MONADS_SIMD_INLINE static auto run(const maybe<any_>* values, std::size_t size) noexcept
+               -> std::size_t
+            {
+               const auto* in = lanes<any_>::data(values);
+
+               std::size_t count = 0;
+               for (std::size_t i = 0; i < size; ++i)
+               {
+                  count += lanes<any_>::engaged(in, i) ? 1U : 0U;
+               }
+
+               return count;
+            }
+         };
+
+         struct value_or_kernel
+         {
+            template <class any_>
+            MONADS_SIMD_INLINE static void run(const maybe<any_>* values, std::size_t size,
+                                               any_ fallback, any_* __restrict out) noexcept
+            {
+               const auto* in = lanes<any_>::data(values);
+
+               for (std::size_t i = 0; i < size; ++i)
+               {
+                  const any_ value = lanes<any_>::value(in, i);
+                  out[i] = lanes<any_>::engaged(in, i) ? value : fallback;
+               }
+            }
+         };
+
+         struct map_kernel
+         {
+            template <class any_, class result_, class fun_>
+            MONADS_SIMD_INLINE static void run(const maybe<any_>* values, std::size_t size,
+                                               const fun_* fun, maybe<result_>* __restrict out)
+            {
+               const auto* in = lanes<any_>::data(values);
+               auto* dest = lanes<result_>::data(out);
+
+               for (std::size_t i = 0; i < size; ++i)
+               {
+                  const bool engaged = lanes<any_>::engaged(in, i);
+                  const any_ stored = lanes<any_>::value(in, i);
+                  const any_ value = engaged ? stored : any_{};
+                  const result_ mapped = std::invoke(*fun, value);
+
+                  lanes<result_>::store(dest, i, engaged, mapped);
+               }
+            }
+         };
+
+         struct validity_kernel
+         {
+            template <class any_>
+            MONADS_SIMD_INLINE static void run(const maybe<any_>* values, std::size_t size,
+                                               std::uint64_t* __restrict out) noexcept
+            {
+               const auto* in = lanes<any_>::data(values);
+
+               for (std::size_t w = 0; w * 64 < size; ++w)
+               {
+                  const std::size_t count = std::min<std::size_t>(64, size - w * 64);
+
+                  std::uint64_t word = 0;
+                  for (std::size_t j = 0; j < count; ++j)
+                  {
+                     word |= std::uint64_t{lanes<any_>::engaged(in, w * 64 + j)} << j;
+                  }
+
+                  out[w] = word;
+               }
+            }
+         };
+
+         struct mask_and_kernel
+         {
+            MONADS_SIMD_INLINE static void run(const std::uint64_t* lhs, const std::uint64_t* rhs,
+                                               std::size_t size,
+                                               std::uint64_t* __restrict out) noexcept
+            {
+               for (std::size_t i = 0; i < size; ++i)
+               {
+                  out[i] = lhs[i] & rhs[i];
+               }
+            }
+         };
+
+         struct mask_or_kernel
+         {
+            MONADS_SIMD_INLINE static void run(const std::uint64_t* lhs, const std::uint64_t* rhs,
+                                               std::size_t size,
+                                               std::uint64_t* __restrict out) noexcept
+            {
+               for (std::size_t i = 0; i < size; ++i)
+               {
+                  out[i] = lhs[i] | rhs[i];
+               }
+            }
+         };
+
+         template <class kernel_, class... args_>
+         MONADS_SIMD_TARGET_AVX512 auto run_avx512(args_... args)
+         {
+            return kernel_::run(args...);
+         }
+
+         template <class kernel_, class... args_>
+         MONADS_SIMD_TARGET_AVX2 auto run_avx2(args_... args)
+         {
+            return kernel_::run(args...);
+         }
+
+         template <class kernel_, class... args_>
+         auto run_sse2(args_... args)
+         {
+            return kernel_::run(args...);
+         }
+
+         template <class kernel_, class... args_>
+         auto dispatch(isa target, args_... args)
+         {
+            switch (target)
+            {
+               case isa::avx512:
+                  return run_avx512<kernel_>(args...);
+               case isa::avx2:
+                  return run_avx2<kernel_>(args...);
+               default:
+                  return run_sse2<kernel_>(args...);
+            }
+         }
+      } // namespace detail
+
+      /**
+       * Count the number of engaged elements
+       */
+      template <detail::maybe_range range_>
+      auto count_engaged(const range_& values, isa target = active_isa()) noexcept -> std::size_t
+      {
+         using value_type = detail::maybe_value_t<range_>;
+
+         if constexpr (detail::lane_layout<value_type>)
+         {
+            if (target != isa::scalar)
+            {
+               return detail::dispatch<detail::count_kernel>(target, std::ranges::data(values),
+                                                             std::ranges::size(values));
+            }
+         }
+
+         std::size_t count = 0;
+         for (const auto& value : values)
+         {
+            count += value.has_value() ? 1U : 0U;
+         }
+
+         return count;
+      }
+
+      /**
+       * Write the stored values into out, with empty elements replaced by a specified value. out
+       * must hold at least as many elements as values
+       */
+      template <detail::maybe_range range_>
+      void value_or(const range_& values, const detail::maybe_value_t<range_>& fallback,
+                    std::span<detail::maybe_value_t<range_>> out, isa target = active_isa())
+      {
+         using value_type = detail::maybe_value_t<range_>;
+
+         assert(out.size() >= std::ranges::size(values));
+
+         if constexpr (detail::lane_layout<value_type>)
+         {
+            if (target != isa::scalar)
+            {
+               detail::dispatch<detail::value_or_kernel>(target, std::ranges::data(values),
+                                                         std::ranges::size(values), fallback,
+                                                         out.data());
+               return;
+            }
+         }
+
+         std::size_t i = 0;
+         for (const auto& value : values)
+         {
+            out[i++] = value.value_or(fallback);
+         }
+      }
+
+      /**
+       * Carries out some operation on every engaged element, writing the results into out. out must
+       * hold at least as many elements as values.
+       *
+       * On the vectorized path fun is also invoked on a value initialized T for empty elements and
+       * its result discarded, so it should be a side effect free arithmetic function
+       */
+      template <detail::maybe_range range_, class fun_>
+      void map(
+         const range_& values, const fun_& fun,
+         std::span<maybe<std::invoke_result_t<const fun_&, detail::maybe_value_t<range_>>>> out,
+         isa target = active_isa())
+      {
+         using value_type = detail::maybe_value_t<range_>;
+         using result_type = std::invoke_result_t<const fun_&, value_type>;
+
+         assert(out.size() >= std::ranges::size(values));
+
+         if constexpr (detail::lane_layout<value_type> && detail::lane_layout<result_type> &&
+                       std::is_nothrow_invocable_v<const fun_&, value_type>)
+         {
+            if (target != isa::scalar)
+            {
+               detail::dispatch<detail::map_kernel>(target, std::ranges::data(values),
+                                                    std::ranges::size(values), &fun, out.data());
+               return;
+            }
+         }
+
+         std::size_t i = 0;
+         for (const auto& value : values)
+         {
+            out[i++] = value.map(fun);
+         }
+      }
+
+      /**
+       * Build a validity bitmap of the elements, bit i % 64 of word i / 64 being set if element i
+       * is engaged. out must hold at least (size + 63) / 64 words
+       */
+      template <detail::maybe_range range_>
+      void validity(const range_& values, std::span<std::uint64_t> out, isa target = active_isa())
+      {
+         using value_type = detail::maybe_value_t<range_>;
+
+         const std::size_t size = std::ranges::size(values);
+
+         assert(out.size() >= (size + 63) / 64);
+
+         if constexpr (detail::lane_layout<value_type>)
+         {
+            if (target != isa::scalar)
+            {
+               detail::dispatch<detail::validity_kernel>(target, std::ranges::data(values), size,
+                                                         out.data());
+               return;
+            }
+         }
+
+         std::fill_n(out.begin(), (size + 63) / 64, std::uint64_t{0});
+
+         std::size_t i = 0;
+         for (const auto& value : values)
+         {
+            out[i / 64] |= std::uint64_t{value.has_value()} << (i % 64);
+            ++i;
+         }
+      }
+
+      /**
+       * Intersect two validity bitmaps, out must hold at least lhs.size() words
+       */
+      inline void mask_and(std::span<const std::uint64_t> lhs, std::span<const std::uint64_t> rhs,
+                           std::span<std::uint64_t> out, isa target = active_isa())
+      {
+         assert(lhs.size() == rhs.size() && out.size() >= lhs.size());
+
+         detail::dispatch<detail::mask_and_kernel>(target, lhs.data(), rhs.data(), lhs.size(),
+                                                   out.data());
+      }
+
+      /**
+       * Unite two validity bitmaps, out must hold at least lhs.size() words
+       */
+      inline void mask_or(std::span<const std::uint64_t> lhs, std::span<const std::uint64_t> rhs,
+                          std::span<std::uint64_t> out, isa target = active_isa())
+      {
+         assert(lhs.size() == rhs.size() && out.size() >= lhs.size());
+
+         detail::dispatch<detail::mask_or_kernel>(target, lhs.data(), rhs.data(), lhs.size(),
+                                                  out.data());
+      }
+   } // namespace simd
+
+   MONADS_ABI_END
+} // namespace monad
@@ -0,0 +1,466 @@
+#pragma once
+
+#include "monads/abi.hpp"
+#include "monads/either.hpp"
+#include "monads/maybe.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+namespace monad
+{
+   MONADS_ABI_BEGIN
+
+   namespace detail
+   {
+      /**
+       * Storage of a sum type: a union of every alternative, built recursively so that it remains
+       * usable in constant evaluation. The active member is tracked by the owning sum
+       */
+      template <class... types_>
+      union sum_storage
+      {
+      };
+
+      template <class first_, class... rest_>
+      union sum_storage<first_, rest_...>
+      {
+         static constexpr bool is_trivially_destructible =
+            trivially_destructible<first_> && (trivially_destructible<rest_> && ...);
+
+         constexpr sum_storage() noexcept : m_empty{} {}
+         template <class... args_>
+         constexpr sum_storage(std::in_place_index_t<0>, args_&&... args) :
+            m_head(std::forward<args_>(args)...)
+         {}
+         template <std::size_t index_, class... args_>
+         constexpr sum_storage(std::in_place_index_t<index_>, args_&&... args) :
+            m_tail(std::in_place_index<index_ - 1>, std::forward<args_>(args)...)
+         {}
+         constexpr ~sum_storage() requires is_trivially_destructible = default;
+         constexpr ~sum_storage() {}
+
+         std::byte m_empty;
+         first_ m_head;
+         sum_storage<rest_...> m_tail;
+      };
+
+      template <std::size_t index_, class storage_>
+      constexpr auto sum_get(storage_&& storage) noexcept -> auto&&
+      {
+         if constexpr (index_ == 0)
+         {
+            return std::forward<storage_>(storage).m_head;
+         }
+         else
+         {
+            return sum_get<index_ - 1>(std::forward<storage_>(storage).m_tail);
+         }
+      }
+
+      template <class result_, class fun_, std::size_t index_>
+      constexpr auto sum_invoke_at(fun_&& fun) -> result_
+      {
+         return std::invoke(std::forward<fun_>(fun), std::integral_constant<std::size_t, index_>{});
+      }
+
+      template <class fun_, class indices_>
+      struct sum_jump_table;
+
+      /**
+       * One entry per alternative, each calling the function with the index of its alternative
+       * as a compile time constant
+       */
+      template <class fun_, std::size_t... indices_>
+      struct sum_jump_table<fun_, std::index_sequence<indices_...>>
+      {
+         using result_type = std::common_type_t<
+            std::invoke_result_t<fun_, std::integral_constant<std::size_t, indices_>>...>;
+
+         static constexpr std::array<result_type (*)(fun_&&), sizeof...(indices_)> entries{
+            &sum_invoke_at<result_type, fun_, indices_>...};
+      };
+
+      /**
+       * Call fun with std::integral_constant<std::size_t, index>. Up to 8 alternatives this is a
+       * dense switch, which compilers lower to a jump table while still inlining each case. Past
+       * that the jump table is built explicitly as an array of function pointers
+       */
+      template <std::size_t size_, class fun_>
+      constexpr auto sum_dispatch(std::size_t index, fun_&& fun) -> decltype(auto)
+      {
+         using table = sum_jump_table<fun_, std::make_index_sequence<size_>>;
+         using result_type = typename table::result_type;
+
+         constexpr auto at = [](std::size_t i) { return std::min(i, size_ - 1); };
+
+         if constexpr (size_ <= 8)
+         {
+            switch (index)
+            {
+               case 0:
+                  return sum_invoke_at<result_type, fun_, at(0)>(std::forward<fun_>(fun));
+               case 1:
+                  return sum_invoke_at<result_type, fun_, at(1)>(std::forward<fun_>(fun));
+               case 2:
+                  return sum_invoke_at<result_type, fun_, at(2)>(std::forward<fun_>(fun));
+               case 3:
+                  return sum_invoke_at<result_type, fun_, at(3)>(std::forward<fun_>(fun));
+               case 4:
+                  return sum_invoke_at<result_type, fun_, at(4)>(std::forward<fun_>(fun));
+               case 5:
+                  return sum_invoke_at<result_type, fun_, at(5)>(std::forward<fun_>(fun));
+               case 6:
+                  return sum_invoke_at<result_type, fun_, at(6)>(std::forward<fun_>(fun));
+               default:
+                  return sum_invoke_at<result_type, fun_, at(7)>(std::forward<fun_>(fun));
+            }
+         }
+         else
+         {
+            return table::entries[index](std::forward<fun_>(fun));
+         }
+      }
+
+      template <class any_, class... types_>
+      inline constexpr std::size_t occurrences = (std::size_t{std::is_same_v<any_, types_>} + ...);
+
+      template <class any_, class... types_>
+      consteval auto index_of() noexcept -> std::size_t
+      {
+         constexpr std::array<bool, sizeof...(types_)> matches{std::is_same_v<any_, types_>...};
+
+         for (std::size_t i = 0; i < matches.size(); ++i)
+         {
+            if (matches[i])
+            {
+               return i;
+            }
+         }
+
+         return matches.size();
+      }
+
+   } // namespace detail
+
+   /**
+    * Holds exactly one value out of a list of alternatives. Unlike nested either, the
+    * discriminant is a single integer sized to the number of alternatives, and match/join
+    * dispatch through a jump table generated at compile time
+    */
+   // clang-format off
+   template <class... types_>
+      requires (sizeof...(types_) > 0 && (!std::is_reference_v<types_> && ...))
+   class sum
+   // clang-format on
+   {
+      using index_type =
+         std::conditional_t<sizeof...(types_) <= std::numeric_limits<std::uint8_t>::max(),
+                            std::uint8_t, std::uint16_t>;
+
+      template <std::size_t index_>
+      using type_at = std::tuple_element_t<index_, std::tuple<types_...>>;
+
+      template <class any_>
+      static constexpr bool is_unique = detail::occurrences<any_, types_...> == 1;
+
+      template <class any_>
+      static constexpr std::size_t index_of = detail::index_of<any_, types_...>();
+
+      // clang-format off
+      static constexpr bool is_trivially_copy_constructible =
+         (trivially_copy_constructible<types_> && ...);
+
+      static constexpr bool is_trivially_move_constructible =
+         (trivially_move_constructible<types_> && ...);
+
+      static constexpr bool is_trivially_destructible =
+         (trivially_destructible<types_> && ...);
+
+      static constexpr bool is_trivially_copy_assignable =
+         (trivially_copy_assignable<types_> && ...);
+
+      static constexpr bool is_trivially_move_assignable =
+         (trivially_move_assignable<types_> && ...);
+
+      static constexpr bool is_nothrow_copy_constructible =
+         (std::is_nothrow_copy_constructible_v<types_> && ...);
+
+      static constexpr bool is_nothrow_move_constructible =
+         (std::is_nothrow_move_constructible_v<types_> && ...);
+
+      static constexpr bool is_nothrow_destructible =
+         (std::is_nothrow_destructible_v<types_> && ...);
+      // clang-format on
+
+   public:
+      /**
+       * The number of alternatives
+       */
+      static constexpr std::size_t size = sizeof...(types_);
+
+      template <std::size_t index_>
+      using alternative = type_at<index_>;
+
+      constexpr sum() noexcept(std::is_nothrow_default_constructible_v<type_at<0>>) requires
+         std::default_initializable<type_at<0>> : sum{std::in_place_index<0>}
+      {}
+      /**
+       * Construct the alternative at index_ in place from the arguments
+       */
+      template <std::size_t index_, class... args_>
+         requires(index_ < size) && std::constructible_from<type_at<index_>, args_...>
+      constexpr sum(std::in_place_index_t<index_> tag, args_&&... args) noexcept(
+         std::is_nothrow_constructible_v<type_at<index_>, args_...>) :
+         m_storage{tag, std::forward<args_>(args)...}, m_index{index_}
+      {}
+      /**
+       * Construct the alternative of type any_ in place from the arguments, any_ must appear
+       * exactly once in the alternatives
+       */
+      template <class any_, class... args_>
+         requires is_unique<any_> && std::constructible_from<any_, args_...>
+      constexpr sum(std::in_place_type_t<any_>, args_&&... args) noexcept(
+         std::is_nothrow_constructible_v<any_, args_...>) :
+         sum{std::in_place_index<index_of<any_>>, std::forward<args_>(args)...}
+      {}
+      /**
+       * Construct the alternative whose type is exactly the type of the value
+       */
+      template <class any_>
+         requires is_unique<std::remove_cvref_t<any_>>
+      constexpr sum(any_&& value) noexcept(
+         std::is_nothrow_constructible_v<std::remove_cvref_t<any_>, any_>) :
+         sum{std::in_place_index<index_of<std::remove_cvref_t<any_>>>, std::forward<any_>(value)}
+      {}
+
+      constexpr sum(const sum&) requires is_trivially_copy_constructible = default;
+      constexpr sum(const sum& rhs) noexcept(is_nothrow_copy_constructible) : m_index{rhs.m_index}
+      {
+         construct_from(rhs);
+      }
+      constexpr sum(sum&&) requires is_trivially_move_constructible = default;
+      constexpr sum(sum&& rhs) noexcept(is_nothrow_move_constructible) : m_index{rhs.m_index}
+      {
+         construct_from(std::move(rhs));
+      }
+      constexpr ~sum() requires is_trivially_destructible = default;
+      constexpr ~sum() noexcept(is_nothrow_destructible) { destroy(); }
+
+      constexpr auto operator=(const sum&) -> sum& requires
+         detail::copy_replaceable<types_...> && is_trivially_copy_assignable = default;
+      /**
+       * Copy the alternative of rhs through emplace, so that a copy which throws leaves the
+       * current alternative untouched
+       */
+      constexpr auto operator=(const sum& rhs) noexcept(is_nothrow_copy_constructible &&
+                                                        is_nothrow_destructible)
+         -> sum& requires detail::copy_replaceable<types_...>
+      {
+         if (this != &rhs)
+         {
+            detail::sum_dispatch<size>(rhs.m_index, [&](auto index) {
+               emplace<index>(detail::sum_get<index>(rhs.m_storage));
+            });
+         }
+
+         return *this;
+      }
+      constexpr auto operator=(sum&&) -> sum& requires
+         detail::move_replaceable<types_...> && is_trivially_move_assignable = default;
+      /**
+       * Move the alternative of rhs in through emplace. Every alternative must be nothrow move
+       * constructible, so that the current alternative is only destroyed by a move that cannot
+       * fail
+       */
+      constexpr auto operator=(sum&& rhs) noexcept(is_nothrow_destructible)
+         -> sum& requires detail::move_replaceable<types_...>
+      {
+         if (this != &rhs)
+         {
+            detail::sum_dispatch<size>(rhs.m_index, [&](auto index) {
+               emplace<index>(detail::sum_get<index>(std::move(rhs.m_storage)));
+            });
+         }
+
+         return *this;
+      }
+
+      /**
+       * The index of the alternative currently held
+       */
+      [[nodiscard]] constexpr auto index() const noexcept -> std::size_t { return m_index; }
+
+      template <std::size_t index_>
+      [[nodiscard]] constexpr auto holds() const noexcept -> bool
+      {
+         return m_index == index_;
+      }
+      template <class any_>
+      [[nodiscard]] constexpr auto holds() const noexcept -> bool requires is_unique<any_>
+      {
+         return m_index == index_of<any_>;
+      }
+
+      /**
+       * Return a copy of the alternative at index_ if it is the one held
+       */
+      template <std::size_t index_>
+      constexpr auto get() const& -> maybe<type_at<index_>> requires std::copyable<type_at<index_>>
+      {
+         return holds<index_>() ? make_maybe(detail::sum_get<index_>(m_storage)) : none;
+      }
+      /**
+       * Move out the alternative at index_ if it is the one held
+       */
+      template <std::size_t index_>
+      constexpr auto get() && -> maybe<type_at<index_>> requires std::movable<type_at<index_>>
+      {
+         return holds<index_>() ? make_maybe(detail::sum_get<index_>(std::move(m_storage))) : none;
+      }
+
+      /**
+       * Access the alternative at index_ without copying it, returns nullptr if another
+       * alternative is held
+       */
+      template <std::size_t index_>
+      constexpr auto get_ptr() noexcept -> type_at<index_>*
+      {
+         return holds<index_>() ? std::addressof(detail::sum_get<index_>(m_storage)) : nullptr;
+      }
+      /**
+       * Access the alternative at index_ without copying it, returns nullptr if another
+       * alternative is held
+       */
+      template <std::size_t index_>
+      constexpr auto get_ptr() const noexcept -> const type_at<index_>*
+      {
+         return holds<index_>() ? std::addressof(detail::sum_get<index_>(m_storage)) : nullptr;
+      }
+
+      /**
+       * Destroy the current alternative and construct the one at index_ from the arguments. If
+       * the construction may throw, the alternative is built first and moved in, which must not
+       * throw, so that the current alternative survives a failed construction
+       */
+      // clang-format off
+      template <std::size_t index_, class... args_>
+         requires(index_ < size) && std::constructible_from<type_at<index_>, args_...> &&
+         (std::is_nothrow_constructible_v<type_at<index_>, args_...> ||
+          std::is_nothrow_move_constructible_v<type_at<index_>>)
+      // clang-format on
+      constexpr auto emplace(args_&&... args) -> type_at<index_>&
+      {
+         if constexpr (std::is_nothrow_constructible_v<type_at<index_>, args_...>)
+         {
+            destroy();
+            std::construct_at(std::addressof(detail::sum_get<index_>(m_storage)),
+                              std::forward<args_>(args)...);
+         }
+         else
+         {
+            type_at<index_> temporary(std::forward<args_>(args)...);
+
+            destroy();
+            std::construct_at(std::addressof(detail::sum_get<index_>(m_storage)),
+                              std::move(temporary));
+         }
+
+         m_index = index_;
+
+         return detail::sum_get<index_>(m_storage);
+      }
+
+      /**
+       * Call a visitor with the alternative held, the visitor must accept every alternative
+       */
+      constexpr auto match(auto&& visitor) const& -> decltype(auto)
+      {
+         return detail::sum_dispatch<size>(m_index, [&](auto index) -> decltype(auto) {
+            return std::invoke(visitor, detail::sum_get<index>(m_storage));
+         });
+      }
+      /**
+       * Call a visitor with the alternative held, the visitor must accept every alternative
+       */
+      constexpr auto match(auto&& visitor) && -> decltype(auto)
+      {
+         return detail::sum_dispatch<size>(m_index, [&](auto index) -> decltype(auto) {
+            return std::invoke(visitor, detail::sum_get<index>(std::move(m_storage)));
+         });
+      }
+
+      /**
+       * Call the function matching the alternative held, one function per alternative in order,
+       * and return their common result
+       */
+      template <class... funs_>
+         requires(sizeof...(funs_) == size)
+      constexpr auto join(const funs_&... funs) const&
+      {
+         const auto overloads = std::forward_as_tuple(funs...);
+
+         return detail::sum_dispatch<size>(m_index, [&](auto index) {
+            return std::invoke(std::get<index>(overloads), detail::sum_get<index>(m_storage));
+         });
+      }
+      /**
+       * Call the function matching the alternative held, one function per alternative in order,
+       * and return their common result
+       */
+      template <class... funs_>
+         requires(sizeof...(funs_) == size)
+      constexpr auto join(const funs_&... funs) &&
+      {
+         const auto overloads = std::forward_as_tuple(funs...);
+
+         return detail::sum_dispatch<size>(m_index, [&](auto index) {
+            return std::invoke(std::get<index>(overloads),
+                               detail::sum_get<index>(std::move(m_storage)));
+         });
+      }
+
+   private:
+      constexpr void construct_from(const sum& rhs)
+      {
+         detail::sum_dispatch<size>(m_index, [&](auto index) {
+            std::construct_at(std::addressof(detail::sum_get<index>(m_storage)),
+                              detail::sum_get<index>(rhs.m_storage));
+         });
+      }
+      constexpr void construct_from(sum&& rhs)
+      {
+         detail::sum_dispatch<size>(m_index, [&](auto index) {
+            std::construct_at(std::addressof(detail::sum_get<index>(m_storage)),
+                              detail::sum_get<index>(std::move(rhs.m_storage)));
+         });
+      }
+
+      constexpr void destroy() noexcept(is_nothrow_destructible)
+      {
+         if constexpr (!is_trivially_destructible)
+         {
+            detail::sum_dispatch<size>(m_index, [&](auto index) {
+               std::destroy_at(std::addressof(detail::sum_get<index>(m_storage)));
+            });
+         }
+      }
+
+   private:
+      static_assert(sizeof(detail::sum_storage<types_...>) ==
+                    (detail::max(sizeof(types_)...) + detail::max(alignof(types_)...) - 1) /
+                       detail::max(alignof(types_)...) * detail::max(alignof(types_)...));
+
+      detail::sum_storage<types_...> m_storage;
+      index_type m_index{0};
+   };
+
+   MONADS_ABI_END
+} // namespace monad
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "monads/abi.hpp"
+#include "monads/pipe.hpp"
+
+#include <functional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace monad
+{
+   MONADS_ABI_BEGIN
+
+   namespace detail
+   {
+      /**
+       * Elements of an rvalue range that owns them are moved out, elements of an lvalue or a
+       * borrowed range are only read
+       */
+      template <class range_>
+      inline constexpr bool moves_elements =
+         !std::is_lvalue_reference_v<range_> && !std::ranges::borrowed_range<range_>;
+
+      template <class range_>
+      using traverse_element_t =
+         std::conditional_t<moves_elements<range_>, std::ranges::range_rvalue_reference_t<range_>,
+                            std::ranges::range_reference_t<range_>>;
+
+      template <class range_, class fun_>
+      using traverse_monad_t =
+         std::remove_cvref_t<std::invoke_result_t<fun_&, traverse_element_t<range_>>>;
+
+      template <class range_, class fun_>
+      using traverse_value_t =
+         std::remove_cvref_t<typename pipe_traits<traverse_monad_t<range_, fun_>>::value_type>;
+
+      template <class range_, class fun_>
+      using traverse_traits = pipe_traits<traverse_monad_t<range_, fun_>>;
+
+      template <class range_, class fun_>
+      using traverse_result_t = typename traverse_traits<range_, fun_>::template rebind<
+         std::vector<traverse_value_t<range_, fun_>>>;
+
+      // clang-format off
+      template <class range_, class fun_>
+      concept traversable = std::ranges::input_range<range_> &&
+         requires { typename traverse_result_t<range_, fun_>; } &&
+         !std::is_void_v<traverse_value_t<range_, fun_>>;
+      // clang-format on
+
+      struct forward_element
+      {
+         template <class any_>
+         constexpr auto operator()(any_&& element) const noexcept -> any_&&
+         {
+            return std::forward<any_>(element);
+         }
+      };
+   } // namespace detail
+
+   /**
+    * Apply a function returning a maybe, a result or an either to every element of a range and
+    * collect the values into a vector. The vector is reserved once when the size of the range is
+    * known. The first failure is returned as is, and the elements after it are never visited
+    */
+   template <class range_, class fun_>
+      requires detail::traversable<range_, fun_>
+   constexpr auto traverse(range_&& range, fun_&& fun) -> detail::traverse_result_t<range_, fun_>
+   {
+      using traits = detail::traverse_traits<range_, fun_>;
+      using value_type = detail::traverse_value_t<range_, fun_>;
+
+      std::vector<value_type> values;
+
+      if constexpr (std::ranges::sized_range<range_>)
+      {
+         values.reserve(std::ranges::size(range));
+      }
+
+      for (auto&& element : range)
+      {
+         decltype(auto) next =
+            std::invoke(fun, static_cast<detail::traverse_element_t<range_>>(element));
+
+         if (!traits::has_value(next))
+         {
+            return traits::template failure<std::vector<value_type>>(
+               std::forward<decltype(next)>(next));
+         }
+
+         values.push_back(traits::value(std::forward<decltype(next)>(next)));
+      }
+
+      return traits::success(std::move(values));
+   }
+
+   /**
+    * Turn a range of maybe, result or either into a single monad holding a vector of the values,
+    * or the first failure of the range
+    */
+   template <class range_>
+      requires detail::traversable<range_, detail::forward_element>
+   constexpr auto sequence(range_&& range)
+      -> detail::traverse_result_t<range_, detail::forward_element>
+   {
+      return traverse(std::forward<range_>(range), detail::forward_element{});
+   }
+
+   MONADS_ABI_END
+} // namespace monad
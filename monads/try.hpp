@@ -1,20 +1,148 @@
 #pragma once
 
+#include <monads/abi.hpp>
 #include <monads/result.hpp>
+#include <monads/sum.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace monad
 {
-   template <class error_, class... args_>
-   auto try_wrap(const std::invocable<args_...> auto& fun, args_&&... args)
-      -> result<std::invoke_result_t<decltype(fun), args_...>, error_>
+   MONADS_ABI_BEGIN
+
+   namespace detail
    {
-      try
+      template <class fun_, class... args_>
+      using try_value_t = std::remove_cvref_t<std::invoke_result_t<fun_, args_...>>;
+
+      template <class any_>
+      struct caught_exceptions
+      {
+         static constexpr bool is_sum = false;
+
+         using type = std::tuple<any_>;
+      };
+
+      template <class... exceptions_>
+      struct caught_exceptions<sum<exceptions_...>>
       {
-         return make_value(std::invoke(fun, std::forward<args_>(args)...));
+         static constexpr bool is_sum = true;
+
+         using type = std::tuple<exceptions_...>;
+      };
+
+      /**
+       * Run the body inside one try block per exception type. The block of the first type is the
+       * innermost, so the types are matched in the order they are listed, like consecutive catch
+       * clauses. Unlike catch clauses, an exception thrown while handling one type may be caught
+       * by the block of a type listed after it
+       */
+      template <class exceptions_, std::size_t count_, class out_>
+      constexpr auto guarded(auto& body, auto& handler) -> out_
+      {
+         if constexpr (count_ == 0)
+         {
+            return body();
+         }
+         else
+         {
+            using exception_type = std::tuple_element_t<count_ - 1, exceptions_>;
+
+            try
+            {
+               return guarded<exceptions_, count_ - 1, out_>(body, handler);
+            }
+            catch (exception_type& e)
+            {
+               return handler(std::integral_constant<std::size_t, count_ - 1>{}, std::move(e));
+            }
+         }
       }
-      catch (const error_& e)
+
+      template <class out_, class exceptions_, class fun_, class... args_>
+      constexpr auto try_invoke(auto&& handler, fun_&& fun, args_&&... args) -> out_
       {
-         return make_error(e);
+         auto body = [&]() -> out_ {
+            if constexpr (std::is_void_v<std::invoke_result_t<fun_, args_...>>)
+            {
+               std::invoke(std::forward<fun_>(fun), std::forward<args_>(args)...);
+
+               return {};
+            }
+            else
+            {
+               return {std::in_place_index<0>,
+                       std::invoke(std::forward<fun_>(fun), std::forward<args_>(args)...)};
+            }
+         };
+
+         if constexpr (std::is_nothrow_invocable_v<fun_, args_...>)
+         {
+            return body();
+         }
+         else
+         {
+            return guarded<exceptions_, std::tuple_size_v<exceptions_>, out_>(body, handler);
+         }
       }
+   } // namespace detail
+
+   /**
+    * Call a function and catch the exceptions of type error_ it throws, returning either its
+    * value or the caught exception moved into the error. When error_ is a sum<Ts...>, each of Ts
+    * is caught, in order, into its alternative. No handler is set up for a noexcept function
+    */
+   template <class error_, class fun_, class... args_>
+      requires std::invocable<fun_, args_...>
+   constexpr auto try_wrap(fun_&& fun, args_&&... args)
+      -> result<detail::try_value_t<fun_, args_...>, error_>
+   {
+      using out_type = result<detail::try_value_t<fun_, args_...>, error_>;
+      using caught = detail::caught_exceptions<error_>;
+
+      const auto handler = [](auto index, auto&& e) -> out_type {
+         if constexpr (caught::is_sum)
+         {
+            return {std::in_place_index<1>, std::in_place_index<decltype(index)::value>,
+                    std::forward<decltype(e)>(e)};
+         }
+         else
+         {
+            return {std::in_place_index<1>, std::forward<decltype(e)>(e)};
+         }
+      };
+
+      return detail::try_invoke<out_type, typename caught::type>(handler, std::forward<fun_>(fun),
+                                                                 std::forward<args_>(args)...);
    }
+
+   /**
+    * Call a function and catch the exceptions of the listed types it throws, in order, passing
+    * the caught exception to a translator by rvalue. The error type is the common type of the
+    * translations. No handler is set up for a noexcept function
+    */
+   template <class... exceptions_, class translator_, class fun_, class... args_>
+      requires(sizeof...(exceptions_) > 0) && std::invocable<fun_, args_...> &&
+      (std::invocable<const translator_&, exceptions_&&> && ...)
+   constexpr auto try_translate(const translator_& translate, fun_&& fun, args_&&... args)
+      -> result<detail::try_value_t<fun_, args_...>,
+                std::common_type_t<std::invoke_result_t<const translator_&, exceptions_&&>...>>
+   {
+      using error_type =
+         std::common_type_t<std::invoke_result_t<const translator_&, exceptions_&&>...>;
+      using out_type = result<detail::try_value_t<fun_, args_...>, error_type>;
+
+      const auto handler = [&](auto, auto&& e) -> out_type {
+         return {std::in_place_index<1>, std::invoke(translate, std::forward<decltype(e)>(e))};
+      };
+
+      return detail::try_invoke<out_type, std::tuple<exceptions_...>>(
+         handler, std::forward<fun_>(fun), std::forward<args_>(args)...);
+   }
+
+   MONADS_ABI_END
 } // namespace monad
@@ -1,10 +1,14 @@
 #pragma once
 
+#include "monads/abi.hpp"
+
 #include <concepts>
 #include <type_traits>
 
 namespace monad
 {
+   MONADS_ABI_BEGIN
+
    // clang-format off
    template <typename any_>
    concept trivially_default_constructible = std::is_trivially_default_constructible_v<any_>;
@@ -15,10 +19,30 @@ namespace monad
    template <typename any_>
    concept trivially_destructible = std::is_trivially_destructible_v<any_>;
 
+   template <typename any_>
+   concept trivially_copy_constructible = std::is_trivially_copy_constructible_v<any_>;
+
+   template <typename any_>
+   concept trivially_move_constructible = std::is_trivially_move_constructible_v<any_>;
+
+   template <typename any_>
+   concept trivially_copy_assignable = 
+      trivially_copy_constructible<any_> &&
+      std::is_trivially_copy_assignable_v<any_> &&
+      trivially_destructible<any_>;
+
+   template <typename any_>
+   concept trivially_move_assignable = 
+      trivially_move_constructible<any_> &&
+      std::is_trivially_move_assignable_v<any_> &&
+      trivially_destructible<any_>;
+
    template <typename any_>
    concept trivial = 
       trivially_default_constructible<any_> &&
       trivially_copyable<any_> &&  
       trivially_destructible<any_>;
    // clang-format on
+
+   MONADS_ABI_END
 } // namespace monad
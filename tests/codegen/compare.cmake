@@ -0,0 +1,134 @@
+# Compare the code generated for each monadic_<name> function of snippets.cpp against its
+# hand_<name> counterpart. A monadic function fails the test when it makes more calls or more
+# stack accesses than the hand written one, or when it has more instructions than the hand written
+# one plus its snapshot below. Cold parts split out by the compiler count towards their function.
+#
+# cmake -DOBJDUMP=<objdump> -DOBJECTS=<snippets object file> -P compare.cmake
+
+# Extra instructions over the hand written version, as measured with GCC 12 when the snippet was
+# added. These are snapshot thresholds catching regressions, not a proof that the monads cost
+# nothing: maybe_and_then takes twice the instructions of its hand written version, because GCC
+# rebuilds the engaged flag of the returned maybe in registers (the movabs masks) instead of
+# setting the byte, and result_map_chain rebuilds the returned result on each of its three return
+# paths instead of returning a failed input unchanged. Lower a snapshot when a change removes
+# instructions, raising one is a regression to justify. Extra calls and memory traffic are not
+# allowed at all.
+set(snapshot_maybe_map_value_or 0)
+set(snapshot_maybe_and_then 14)
+set(snapshot_result_and_then 1)
+set(snapshot_result_map_chain 6)
+
+# Snippets whose failure path is deliberately built out of line. The calls and stack accesses of
+# their cold parts are not counted, their instructions still are.
+set(cold_failure_result_context TRUE)
+
+execute_process(
+    COMMAND ${OBJDUMP} -d --no-show-raw-insn ${OBJECTS}
+    OUTPUT_VARIABLE listing
+    RESULT_VARIABLE status
+)
+
+if (NOT status EQUAL 0)
+    message(FATAL_ERROR "${OBJDUMP} failed on ${OBJECTS}")
+endif ()
+
+string(REPLACE ";" "," listing "${listing}")
+string(REPLACE "\n" ";" lines "${listing}")
+
+set(function "")
+set(snippets "")
+
+foreach (line IN LISTS lines)
+    if (line MATCHES "^[0-9a-f]+ <((monadic|hand)_[a-z_]+)(\\.cold)?>:$")
+        set(function ${CMAKE_MATCH_1})
+        set(side ${CMAKE_MATCH_2})
+        set(cold_part "${CMAKE_MATCH_3}")
+        string(REGEX REPLACE "^(monadic|hand)_" "" function_snippet ${function})
+
+        if (cold_part AND cold_failure_${function_snippet})
+            set(count_cold_traffic FALSE)
+        else ()
+            set(count_cold_traffic TRUE)
+        endif ()
+
+        if (NOT DEFINED instructions_${function})
+            set(instructions_${function} 0)
+            set(calls_${function} 0)
+            set(stack_${function} 0)
+        endif ()
+
+        if (side STREQUAL "hand")
+            list(APPEND snippets ${function_snippet})
+        endif ()
+    elseif (line MATCHES "^[0-9a-f]+ <")
+        set(function "")
+    elseif (function AND line MATCHES "^ *[0-9a-f]+:\t([^ ]+)(.*)$")
+        set(mnemonic ${CMAKE_MATCH_1})
+        set(operands "${CMAKE_MATCH_2}")
+
+        # Padding between functions
+        if (mnemonic MATCHES "^(nop|data16|cs|int3|xchg)")
+            continue()
+        endif ()
+
+        math(EXPR instructions_${function} "${instructions_${function}} + 1")
+
+        if (NOT count_cold_traffic)
+            continue()
+        endif ()
+
+        if (mnemonic MATCHES "^call")
+            math(EXPR calls_${function} "${calls_${function}} + 1")
+        endif ()
+
+        if (mnemonic MATCHES "^(push|pop)" OR operands MATCHES "\\(%[re](sp|bp)\\)")
+            math(EXPR stack_${function} "${stack_${function}} + 1")
+        endif ()
+    endif ()
+endforeach ()
+
+if (NOT snippets)
+    message(FATAL_ERROR "No hand_ function found in ${OBJECTS}")
+endif ()
+
+list(REMOVE_DUPLICATES snippets)
+
+set(failures "")
+
+foreach (snippet IN LISTS snippets)
+    set(monadic monadic_${snippet})
+    set(hand hand_${snippet})
+
+    if (NOT DEFINED instructions_${monadic})
+        message(FATAL_ERROR "${hand} has no ${monadic} counterpart")
+    endif ()
+
+    if (NOT DEFINED snapshot_${snippet})
+        set(snapshot_${snippet} 0)
+    endif ()
+
+    math(EXPR allowed "${instructions_${hand}} + ${snapshot_${snippet}}")
+
+    message(STATUS "${snippet}: "
+        "${instructions_${monadic}} instructions (hand ${instructions_${hand}}, allowed ${allowed}), "
+        "${calls_${monadic}} calls (hand ${calls_${hand}}), "
+        "${stack_${monadic}} stack accesses (hand ${stack_${hand}})")
+
+    if (instructions_${monadic} GREATER allowed)
+        list(APPEND failures "${snippet}: ${instructions_${monadic}} instructions, allowed ${allowed}")
+    endif ()
+
+    if (calls_${monadic} GREATER calls_${hand})
+        list(APPEND failures "${snippet}: ${calls_${monadic}} calls, hand written ${calls_${hand}}")
+    endif ()
+
+    if (stack_${monadic} GREATER stack_${hand})
+        list(APPEND failures
+            "${snippet}: ${stack_${monadic}} stack accesses, hand written ${stack_${hand}}")
+    endif ()
+endforeach ()
+
+if (failures)
+    string(REPLACE ";" "\n   " failures "${failures}")
+    message(FATAL_ERROR "The monads generate more code than their snapshots allow:\n   ${failures}")
+endif ()
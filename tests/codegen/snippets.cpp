@@ -0,0 +1,169 @@
+#include <monads/maybe.hpp>
+#include <monads/result.hpp>
+
+#include <array>
+#include <cstddef>
+#include <source_location>
+#include <system_error>
+
+// Pairs of functions doing the same work, once through the monads and once by hand on a plain
+// struct with the same layout. compare.cmake checks that the first of each pair makes no more
+// calls or stack accesses than the second, and has no more instructions than the snapshot taken
+// when the pair was added. The functions have C linkage so that their names are stable.
+
+using namespace monad;
+
+namespace
+{
+   struct hand_maybe
+   {
+      int value;
+      bool engaged;
+   };
+
+   struct hand_result
+   {
+      union
+      {
+         int value;
+         std::errc error;
+      };
+      bool is_error;
+   };
+
+   constexpr auto decrement(int i) noexcept -> result<int, std::errc>
+   {
+      if (i > 0)
+      {
+         return make_value(i - 1);
+      }
+
+      return make_error(std::errc::invalid_argument);
+   }
+
+   constexpr auto hand_decrement(int i) noexcept -> hand_result
+   {
+      hand_result out{};
+
+      if (i > 0)
+      {
+         out.value = i - 1;
+         out.is_error = false;
+      }
+      else
+      {
+         out.error = std::errc::invalid_argument;
+         out.is_error = true;
+      }
+
+      return out;
+   }
+
+   struct hand_frame
+   {
+      const char* what;
+      std::source_location where;
+   };
+
+   struct hand_context_result
+   {
+      union
+      {
+         int value;
+         struct
+         {
+            std::errc error;
+            std::array<hand_frame, 4> frames;
+            std::size_t count;
+         } context;
+      };
+      bool is_error;
+   };
+} // namespace
+
+extern "C"
+{
+   auto monadic_maybe_map_value_or(maybe<int> m) noexcept -> int
+   {
+      return m.map([](int i) { return i * 2; }).value_or(0);
+   }
+
+   auto hand_maybe_map_value_or(hand_maybe m) noexcept -> int
+   {
+      return m.engaged ? m.value * 2 : 0;
+   }
+
+   auto monadic_maybe_and_then(maybe<int> m) noexcept -> maybe<int>
+   {
+      return m.and_then([](int i) { return i > 0 ? maybe<int>{i - 1} : maybe<int>{}; });
+   }
+
+   auto hand_maybe_and_then(hand_maybe m) noexcept -> hand_maybe
+   {
+      if (m.engaged && m.value > 0)
+      {
+         return {m.value - 1, true};
+      }
+
+      return {0, false};
+   }
+
+   auto monadic_result_and_then(result<int, std::errc> r) noexcept -> result<int, std::errc>
+   {
+      return r.and_then(decrement);
+   }
+
+   auto hand_result_and_then(hand_result r) noexcept -> hand_result
+   {
+      return r.is_error ? r : hand_decrement(r.value);
+   }
+
+   auto monadic_result_map_chain(result<int, std::errc> r) noexcept -> result<int, std::errc>
+   {
+      return r.map([](int i) { return i + 1; })
+         .and_then(decrement)
+         .map([](int i) { return i * 3; });
+   }
+
+   auto hand_result_map_chain(hand_result r) noexcept -> hand_result
+   {
+      if (r.is_error)
+      {
+         return r;
+      }
+
+      hand_result out = hand_decrement(r.value + 1);
+
+      if (!out.is_error)
+      {
+         out.value *= 3;
+      }
+
+      return out;
+   }
+
+   auto monadic_result_context(int i) noexcept -> result<int, contextual<std::errc>>
+   {
+      return decrement(i).context("while decrementing");
+   }
+
+   auto hand_result_context(int i) noexcept -> hand_context_result
+   {
+      hand_context_result out{};
+      const hand_result decremented = hand_decrement(i);
+
+      if (decremented.is_error)
+      {
+         out.context.error = decremented.error;
+         out.context.frames[0] = {"while decrementing", std::source_location::current()};
+         out.context.count = 1;
+         out.is_error = true;
+      }
+      else
+      {
+         out.value = decremented.value;
+      }
+
+      return out;
+   }
+}
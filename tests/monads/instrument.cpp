@@ -0,0 +1,149 @@
+#if !defined(MONADS_INSTRUMENT)
+#  define MONADS_INSTRUMENT
+#endif
+
+#include <monads/maybe.hpp>
+#include <monads/parallel.hpp>
+#include <monads/pipe.hpp>
+#include <monads/result.hpp>
+#include <monads/traverse.hpp>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace monad;
+
+namespace
+{
+   auto count_of(error_event_kind kind, error_type_id type) -> std::uint64_t
+   {
+      std::uint64_t count = 0;
+
+      for (const auto& entry : thread_error_counters::local().entries())
+      {
+         if (entry.event.kind == kind && entry.event.type == type)
+         {
+            count += entry.count;
+         }
+      }
+
+      return count;
+   }
+
+   auto checked_half(int i) -> result<int, std::string>
+   {
+      if (i % 2 != 0)
+      {
+         return make_error(std::string{"odd"});
+      }
+
+      return make_value(i / 2);
+   }
+} // namespace
+
+TEST_CASE("error instrumentation test suite")
+{
+   auto& counters = thread_error_counters::local();
+
+   SUBCASE("make_error records its call site")
+   {
+      counters.clear();
+
+      const std::uint_least32_t line = std::source_location::current().line() + 1;
+      const result<int, int> failed = make_error(3);
+
+      REQUIRE(counters.entries().size() == 1);
+      const auto& entry = counters.entries().front();
+      CHECK(entry.event.kind == error_event_kind::made);
+      CHECK(entry.event.type == error_type_id::of<int>());
+      CHECK(entry.event.location.line() == line);
+      CHECK(std::string_view{entry.event.location.file_name()}.ends_with("instrument.cpp"));
+      CHECK(entry.count == 1);
+      CHECK_FALSE(failed.is_value());
+   }
+
+   SUBCASE("short-circuits are counted per site")
+   {
+      counters.clear();
+
+      for (int i = 0; i < 10; ++i)
+      {
+         const auto out = checked_half(i).and_then(checked_half).and_then(checked_half);
+         static_cast<void>(out);
+      }
+
+      const auto string_error = error_type_id::of<std::string>();
+
+      // 5 odd inputs, 2 odd halves of the even ones and 1 odd quarter, each failure of the first
+      // step passing through both and_then and each failure of the second through the last one
+      CHECK(count_of(error_event_kind::made, string_error) == 5 + 2 + 1);
+      CHECK(count_of(error_event_kind::propagated, string_error) == 2 * 5 + 2);
+      CHECK(count_of(error_event_kind::made, error_type_id::of<int>()) == 0);
+   }
+
+   SUBCASE("pipelines and traversals forward errors without making them")
+   {
+      const auto string_error = error_type_id::of<std::string>();
+      const auto from_this_file = [&] {
+         const auto& entries = counters.entries();
+
+         return std::ranges::all_of(entries, [](const auto& entry) {
+            return std::string_view{entry.event.location.file_name()}.ends_with("instrument.cpp");
+         });
+      };
+
+      counters.clear();
+
+      const result<int, std::string> piped =
+         pipe(checked_half(3)) | map([](int i) { return i + 1; }) | and_then(checked_half);
+      CHECK(!piped.is_value());
+      CHECK(count_of(error_event_kind::made, string_error) == 1);
+      CHECK(counters.entries().size() == 1);
+      CHECK(from_this_file());
+
+      counters.clear();
+
+      const std::vector<int> inputs{2, 4, 5, 8};
+
+      CHECK(!traverse(inputs, checked_half).is_value());
+      CHECK(count_of(error_event_kind::made, string_error) == 1);
+      CHECK(counters.entries().size() == 1);
+
+      CHECK(!par_traverse(par_policy{.workers = 1}, inputs, checked_half).is_value());
+      CHECK(count_of(error_event_kind::made, string_error) == 2);
+      CHECK(from_this_file());
+   }
+
+   SUBCASE("empty maybe handled by or_else")
+   {
+      counters.clear();
+
+      int recovered = 0;
+
+      for (int i = 0; i < 4; ++i)
+      {
+         maybe<int>{}.or_else([&] { ++recovered; });
+         maybe<int>{i}.or_else([&] { ++recovered; });
+      }
+
+      CHECK(recovered == 4);
+      REQUIRE(counters.entries().size() == 1);
+      CHECK(counters.entries().front().event.kind == error_event_kind::recovered);
+      CHECK(counters.entries().front().event.type == error_type_id::of<none_t>());
+      CHECK(counters.entries().front().count == 4);
+   }
+
+   SUBCASE("constant evaluation is not instrumented")
+   {
+      counters.clear();
+
+      static_assert(make_error(5).value == 5);
+      CHECK(counters.entries().empty());
+   }
+}
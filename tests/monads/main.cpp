@@ -1,15 +1,66 @@
+#include <monads/binary.hpp>
+#include <monads/boxed.hpp>
+#include <monads/coroutine.hpp>
 #include <monads/either.hpp>
+#include <monads/error.hpp>
 #include <monads/maybe.hpp>
+#include <monads/maybe_vector.hpp>
+#include <monads/parallel.hpp>
+#include <monads/pipe.hpp>
 #include <monads/result.hpp>
+#include <monads/simd.hpp>
+#include <monads/sum.hpp>
+#include <monads/traverse.hpp>
 #include <monads/try.hpp>
 
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <memory_resource>
+#include <limits>
+#include <numeric>
+#include <ranges>
+#include <source_location>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <system_error>
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <doctest/doctest.h>
 
 using namespace monad;
 
+enum class colour : std::uint8_t
+{
+   red,
+   green,
+   blue
+};
+
+template <>
+struct monad::niche<colour> : monad::enum_niche<colour>
+{
+};
+
+struct user_id
+{
+   std::uint32_t id;
+
+   constexpr auto operator==(const user_id&) const -> bool = default;
+};
+
+template <>
+struct monad::niche<user_id> : monad::sentinel_niche<user_id, user_id{0}>
+{
+};
+
 class in_place_struct
 {
 public:
@@ -24,6 +75,114 @@ private:
    int m_y{0};
 };
 
+/**
+ * Approximation of the System V x86-64 rule for passing and returning a class in registers: it
+ * must not have a non-trivial copy/move constructor or destructor and must fit in two eightbytes
+ */
+template <class any_>
+concept register_passable = std::is_trivially_copy_constructible_v<any_> &&
+   std::is_trivially_move_constructible_v<any_> && std::is_trivially_destructible_v<any_> &&
+   sizeof(any_) <= 2 * sizeof(std::uint64_t);
+
+struct aggregate_with_initializer
+{
+   int value{0};
+};
+
+/**
+ * Counts how its instances are created, to check that in-place construction builds exactly once
+ */
+struct counted
+{
+   static inline int constructions = 0;
+   static inline int copies = 0;
+   static inline int moves = 0;
+
+   static void reset_counts() { constructions = copies = moves = 0; }
+
+   counted(int a, int b) noexcept : value{a + b} { ++constructions; }
+   counted(const counted& other) : value{other.value} { ++copies; }
+   counted(counted&& other) noexcept : value{other.value} { ++moves; }
+   ~counted() = default;
+
+   auto operator=(const counted&) -> counted& = default;
+   auto operator=(counted&&) noexcept -> counted& = default;
+
+   int value;
+};
+
+struct immovable
+{
+   explicit immovable(int v) : value{v} {}
+   immovable(const immovable&) = delete;
+   immovable(immovable&&) = delete;
+   ~immovable() = default;
+
+   auto operator=(const immovable&) -> immovable& = delete;
+   auto operator=(immovable&&) -> immovable& = delete;
+
+   int value;
+};
+
+/**
+ * Building or copying it throws while fail is set, moving it does not
+ */
+struct fallible
+{
+   static inline bool fail = false;
+
+   explicit fallible(int v) : value{v} { check(); }
+   fallible(const fallible& rhs) : value{rhs.value} { check(); }
+   fallible(fallible&&) noexcept = default;
+   ~fallible() = default;
+
+   auto operator=(const fallible&) -> fallible& = default;
+   auto operator=(fallible&&) noexcept -> fallible& = default;
+
+   static void check()
+   {
+      if (fail)
+      {
+         throw std::invalid_argument{"failed"};
+      }
+   }
+
+   int value;
+};
+
+/**
+ * Built from one int without throwing, from two or by moving it may throw
+ */
+struct throwing_move
+{
+   explicit throwing_move(int v) noexcept : value{v} {}
+   throwing_move(int lhs, int rhs) : value{lhs + rhs} {}
+   throwing_move(const throwing_move&) = default;
+   throwing_move(throwing_move&& rhs) noexcept(false) : value{rhs.value} {}
+   ~throwing_move() = default;
+
+   auto operator=(const throwing_move&) -> throwing_move& = default;
+   auto operator=(throwing_move&& rhs) noexcept(false) -> throwing_move&
+   {
+      value = rhs.value;
+      return *this;
+   }
+
+   int value;
+};
+
+template <class any_, class... args_>
+concept value_emplaceable = requires(any_& monad, args_&&... args)
+{
+   monad.emplace_value(std::forward<args_>(args)...);
+};
+
+template <class any_, class... args_>
+concept right_emplaceable = requires(any_& monad, args_&&... args)
+{
+   monad.emplace_right(std::forward<args_>(args)...);
+};
+
 TEST_CASE("maybe monad test suite")
 {
    SUBCASE("Default constructor")
@@ -87,3 +246,2131 @@ TEST_CASE("maybe monad test suite")
       CHECK(m->x() == 10);
    }
 }
+
+TEST_CASE("maybe niche optimization test suite")
+{
+   static_assert(sizeof(maybe<int*>) == sizeof(int*));
+   static_assert(sizeof(maybe<const char*>) == sizeof(const char*));
+   static_assert(sizeof(maybe<double>) == sizeof(double));
+   static_assert(sizeof(maybe<float>) == sizeof(float));
+   static_assert(sizeof(maybe<bool>) == sizeof(bool));
+   static_assert(sizeof(maybe<colour>) == sizeof(colour));
+   static_assert(sizeof(maybe<user_id>) == sizeof(user_id));
+   static_assert(sizeof(maybe<std::uint32_t>) == 2 * sizeof(std::uint32_t));
+
+   SUBCASE("pointer")
+   {
+      int i = 10;
+
+      const maybe<int*> empty{};
+      const maybe<int*> m{&i};
+
+      CHECK(empty.has_value() == false);
+      REQUIRE(m.has_value() == true);
+      CHECK(*m.value() == 10);
+      CHECK(maybe<int*>{nullptr}.has_value() == false);
+      CHECK(m.map([](int* p) { return *p * 2; }).value() == 20);
+   }
+
+   SUBCASE("floating point")
+   {
+      const maybe<double> empty{};
+      const maybe<double> m{1.5};
+      const maybe<double> nan{std::numeric_limits<double>::quiet_NaN()};
+
+      CHECK(empty.has_value() == false);
+      REQUIRE(m.has_value() == true);
+      CHECK(m.value() == 1.5);
+      REQUIRE(nan.has_value() == true);
+      CHECK(std::isnan(nan.value()));
+      CHECK(maybe<float>{0.0F}.has_value() == true);
+      CHECK(maybe<float>{}.has_value() == false);
+   }
+
+   SUBCASE("bool")
+   {
+      maybe<bool> m{false};
+
+      REQUIRE(m.has_value() == true);
+      CHECK(m.value() == false);
+
+      m.reset();
+
+      CHECK(m.has_value() == false);
+      CHECK(maybe<bool>{true}.value() == true);
+      CHECK(maybe<bool>{}.has_value() == false);
+   }
+
+   SUBCASE("user declared sentinels")
+   {
+      CHECK(maybe<colour>{}.has_value() == false);
+      CHECK(maybe<colour>{colour::blue}.value() == colour::blue);
+      CHECK(maybe<user_id>{}.has_value() == false);
+      CHECK(maybe<user_id>{user_id{0}}.has_value() == false);
+      CHECK(maybe<user_id>{user_id{42}}.value().id == 42);
+   }
+
+   SUBCASE("swap")
+   {
+      double d = 2.0;
+      maybe<double> lhs{d};
+      maybe<double> rhs{};
+
+      lhs.swap(rhs);
+
+      CHECK(lhs.has_value() == false);
+      REQUIRE(rhs.has_value() == true);
+      CHECK(rhs.value() == 2.0);
+   }
+}
+
+TEST_CASE("trivially copyable monads test suite")
+{
+   static_assert(std::is_trivially_copyable_v<maybe<int>>);
+   static_assert(std::is_trivially_copyable_v<maybe<double>>);
+   static_assert(std::is_trivially_copyable_v<maybe<aggregate_with_initializer>>);
+   static_assert(std::is_trivially_copyable_v<either<int, float>>);
+   static_assert(std::is_trivially_copyable_v<either<aggregate_with_initializer, std::errc>>);
+   static_assert(std::is_trivially_copyable_v<result<int, std::errc>>);
+   static_assert(std::is_trivially_copyable_v<result<aggregate_with_initializer, std::errc>>);
+
+   static_assert(!std::is_trivially_copyable_v<maybe<std::string>>);
+   static_assert(!std::is_trivially_copyable_v<either<int, std::string>>);
+   static_assert(!std::is_trivially_copyable_v<result<std::string, std::errc>>);
+
+   static_assert(register_passable<maybe<int>>);
+   static_assert(register_passable<maybe<std::uint64_t>>);
+   static_assert(register_passable<either<int, std::errc>>);
+   static_assert(register_passable<result<int, std::errc>>);
+   static_assert(register_passable<result<double, std::errc>>);
+   static_assert(register_passable<result<std::uint64_t, std::errc>>);
+
+   static_assert(!register_passable<result<std::string, std::errc>>);
+
+   SUBCASE("non-trivial copy and move")
+   {
+      const result<std::string, int> value{make_value(std::string{"Hello"})};
+      const result<std::string, int> error{make_error(1)};
+
+      result<std::string, int> copy{value};
+      result<std::string, int> moved{std::move(copy)};
+
+      REQUIRE(moved.is_value() == true);
+      CHECK(moved.value() == std::string{"Hello"});
+
+      moved = error;
+
+      REQUIRE(moved.is_value() == false);
+      CHECK(moved.error() == 1);
+
+      moved = result<std::string, int>{make_value(std::string{"World"})};
+
+      REQUIRE(moved.is_value() == true);
+      CHECK(moved.value() == std::string{"World"});
+   }
+
+   SUBCASE("non-trivial either copy and move")
+   {
+      either<int, std::string> e{make_right(std::string{"Hello"})};
+      either<int, std::string> copy{e};
+
+      REQUIRE(copy.is_right() == true);
+      CHECK(copy.right() == std::string{"Hello"});
+
+      copy = either<int, std::string>{make_left(10)};
+
+      REQUIRE(copy.is_right() == false);
+      CHECK(copy.left() == 10);
+   }
+
+   SUBCASE("non-trivial maybe copy and swap")
+   {
+      maybe<std::string> lhs{std::string{"Hello"}};
+      maybe<std::string> rhs{};
+      maybe<std::string> copy = lhs;
+
+      lhs.swap(rhs);
+
+      CHECK(lhs.has_value() == false);
+      REQUIRE(rhs.has_value() == true);
+      CHECK(rhs.value() == "Hello");
+      CHECK(copy.value() == "Hello");
+
+      copy = maybe<std::string>{};
+
+      CHECK(copy.has_value() == false);
+   }
+}
+
+TEST_CASE("zero-copy accessors test suite")
+{
+   SUBCASE("result")
+   {
+      result<std::string, int> r{make_value(std::string{"Hello"})};
+      const result<std::string, int> e{make_error(1)};
+
+      REQUIRE(r.value_ptr() != nullptr);
+      CHECK(*r.value_ptr() == "Hello");
+      CHECK(r.error_ptr() == nullptr);
+      CHECK(e.value_ptr() == nullptr);
+      REQUIRE(e.error_ptr() != nullptr);
+      CHECK(*e.error_ptr() == 1);
+
+      r.value_ptr()->append(" World");
+
+      CHECK(*r.value_ptr() == "Hello World");
+   }
+
+   SUBCASE("either")
+   {
+      const either<int, std::string> l{make_left(1)};
+      const either<int, std::string> r{make_right(std::string{"Hello"})};
+
+      REQUIRE(l.left_ptr() != nullptr);
+      CHECK(*l.left_ptr() == 1);
+      CHECK(l.right_ptr() == nullptr);
+      CHECK(r.left_ptr() == nullptr);
+      REQUIRE(r.right_ptr() != nullptr);
+      CHECK(*r.right_ptr() == "Hello");
+   }
+
+   SUBCASE("non-copyable payload")
+   {
+      const result<std::unique_ptr<int>, int> r{make_value(std::make_unique<int>(10))};
+
+      REQUIRE(r.value_ptr() != nullptr);
+      CHECK(**r.value_ptr() == 10);
+   }
+}
+
+TEST_CASE("maybe reference test suite")
+{
+   static_assert(sizeof(maybe<int&>) == sizeof(int*));
+   static_assert(sizeof(maybe<const std::string&>) == sizeof(const std::string*));
+   static_assert(std::is_trivially_copyable_v<maybe<std::string&>>);
+   static_assert(!std::is_constructible_v<maybe<const int&>, int&&>);
+
+   const auto lookup = [](std::unordered_map<int, std::string>& table,
+                          int key) -> maybe<std::string&> {
+      if (auto it = table.find(key); it != table.end())
+      {
+         return it->second;
+      }
+
+      return none;
+   };
+
+   std::unordered_map<int, std::string> table{{1, "one"}, {2, "two"}};
+
+   SUBCASE("access")
+   {
+      const maybe<std::string&> found = lookup(table, 1);
+      const maybe<std::string&> missing = lookup(table, 3);
+
+      REQUIRE(found.has_value() == true);
+      CHECK(&found.value() == &table[1]);
+      CHECK(found->size() == 3);
+      CHECK(missing.has_value() == false);
+
+      found.value() = "uno";
+
+      CHECK(table[1] == "uno");
+   }
+
+   SUBCASE("rebinding assignment")
+   {
+      int first = 1;
+      int second = 2;
+
+      maybe<int&> m{first};
+      m = maybe<int&>{second};
+
+      CHECK(first == 1);
+      CHECK(&m.value() == &second);
+
+      m.reset();
+
+      CHECK(m.has_value() == false);
+   }
+
+   SUBCASE("combinators")
+   {
+      const auto size = [](const std::string& s) {
+         return s.size();
+      };
+      const auto first_char = [](std::string& s) -> maybe<char&> {
+         return s.empty() ? maybe<char&>{} : maybe<char&>{s.front()};
+      };
+
+      CHECK(lookup(table, 2).map(size).value() == 3);
+      CHECK(lookup(table, 3).map(size).has_value() == false);
+      CHECK(lookup(table, 2).value_or("none") == "two");
+      CHECK(lookup(table, 3).value_or("none") == "none");
+      CHECK(lookup(table, 2).map_or(size, 0U) == 3);
+      CHECK(lookup(table, 3).map_or(size, 0U) == 0);
+      CHECK(lookup(table, 2).and_then(first_char).value() == 't');
+      CHECK(lookup(table, 3).and_then(first_char).has_value() == false);
+
+      bool called = false;
+      const auto missing = lookup(table, 3).or_else([&] {
+         called = true;
+      });
+
+      CHECK(called == true);
+      CHECK(missing.has_value() == false);
+   }
+
+   SUBCASE("map returning a reference")
+   {
+      std::string s{"Hello"};
+      maybe<std::string> m{s};
+
+      const auto identity = [](const std::string& v) -> const std::string& {
+         return v;
+      };
+      const maybe<const std::string&> ref = m.map(identity);
+
+      REQUIRE(ref.has_value() == true);
+      CHECK(&ref.value() == &m.value());
+   }
+}
+
+template <class any_>
+concept maybe_vector_element = requires
+{
+   typename maybe_vector<any_>;
+};
+
+TEST_CASE("maybe_vector test suite")
+{
+   static_assert(maybe_vector_element<int>);
+   static_assert(!maybe_vector_element<bool>);
+
+   using iterator = maybe_vector<int>::const_iterator;
+   static_assert(std::random_access_iterator<iterator>);
+   static_assert(std::is_same_v<std::iterator_traits<iterator>::iterator_category,
+                                std::input_iterator_tag>);
+
+   SUBCASE("construction and access")
+   {
+      const maybe_vector<int> v{1, none, 3};
+
+      REQUIRE(v.size() == 3);
+      CHECK(v[0].value() == 1);
+      CHECK(v[1].has_value() == false);
+      CHECK(v[2].value() == 3);
+      CHECK(v.count_engaged() == 2);
+      CHECK(maybe_vector<int>(100).count_engaged() == 0);
+   }
+
+   SUBCASE("bitmap spanning several words")
+   {
+      maybe_vector<int> v;
+
+      for (int i = 0; i < 200; ++i)
+      {
+         if (i % 3 == 0)
+         {
+            v.push_back(none);
+         }
+         else
+         {
+            v.emplace_back(i);
+         }
+      }
+
+      REQUIRE(v.size() == 200);
+      CHECK(v.validity().size() == 4);
+      CHECK(v.count_engaged() == 133);
+      CHECK(v[130].has_value() == true);
+      CHECK(v[132].has_value() == false);
+
+      v.reset(130);
+      v.set(132, maybe<int>{-1});
+
+      CHECK(v[130].has_value() == false);
+      CHECK(v[132].value() == -1);
+      CHECK(v.count_engaged() == 133);
+   }
+
+   SUBCASE("element references")
+   {
+      maybe_vector<int> v{1, none};
+
+      v[0].value() = 10;
+
+      CHECK(v[0].value() == 10);
+
+      int sum = 0;
+      int empty = 0;
+      for (maybe<int&> element : v)
+      {
+         if (element)
+         {
+            sum += element.value();
+         }
+         else
+         {
+            ++empty;
+         }
+      }
+
+      CHECK(sum == 10);
+      CHECK(empty == 1);
+   }
+
+   SUBCASE("bulk operations")
+   {
+      maybe_vector<int> v;
+
+      for (int i = 0; i < 130; ++i)
+      {
+         v.push_back(i == 70 ? maybe<int>{} : maybe<int>{i});
+      }
+
+      const auto values = v.value_or(-1);
+
+      REQUIRE(values.size() == 130);
+      CHECK(values[69] == 69);
+      CHECK(values[70] == -1);
+
+      const auto doubled = v.map([](int i) {
+         return i * 2.0;
+      });
+
+      REQUIRE(doubled.size() == 130);
+      CHECK(doubled.count_engaged() == 129);
+      CHECK(doubled[129].value() == 258.0);
+      CHECK(doubled[70].has_value() == false);
+   }
+}
+
+TEST_CASE("simd kernels test suite")
+{
+   static_assert(simd::detail::flagged_layout<std::int32_t>);
+   static_assert(simd::detail::flagged_layout<std::uint8_t>);
+   static_assert(simd::detail::flagged_layout<std::int64_t>);
+   static_assert(simd::detail::niche_layout<double>);
+   static_assert(simd::detail::niche_layout<int*>);
+   static_assert(!simd::detail::lane_layout<std::string>);
+
+   std::vector<maybe<std::int32_t>> ints;
+   std::vector<maybe<double>> doubles;
+   std::vector<maybe<std::string>> strings;
+
+   for (int i = 0; i < 1000; ++i)
+   {
+      ints.push_back(i % 3 == 0 ? maybe<std::int32_t>{} : maybe<std::int32_t>{i});
+      doubles.push_back(i % 5 == 0 ? maybe<double>{} : maybe<double>{i * 0.5});
+      strings.push_back(i % 2 == 0 ? maybe<std::string>{} : maybe<std::string>{"s"});
+   }
+
+   for (const auto target : {simd::isa::scalar, simd::isa::sse2, simd::isa::avx2,
+                             simd::isa::avx512})
+   {
+      if (target > simd::active_isa())
+      {
+         continue;
+      }
+
+      CHECK(simd::count_engaged(ints, target) == 666);
+      CHECK(simd::count_engaged(doubles, target) == 800);
+      CHECK(simd::count_engaged(strings, target) == 500);
+
+      std::vector<std::int32_t> values(ints.size());
+      simd::value_or(ints, -1, values, target);
+
+      CHECK(values[0] == -1);
+      CHECK(values[1] == 1);
+      CHECK(values[999] == -1);
+      CHECK(values[998] == 998);
+
+      std::vector<maybe<double>> halves(ints.size());
+      simd::map(
+         ints,
+         [](std::int32_t i) noexcept {
+            return i / 2.0;
+         },
+         halves, target);
+
+      CHECK(halves[0].has_value() == false);
+      CHECK(halves[1].value() == 0.5);
+      CHECK(simd::count_engaged(halves, target) == 666);
+
+      std::vector<maybe<std::int64_t>> squares(doubles.size());
+      simd::map(
+         doubles,
+         [](double d) noexcept {
+            return static_cast<std::int64_t>(d * d);
+         },
+         squares, target);
+
+      CHECK(squares[0].has_value() == false);
+      CHECK(squares[4].value() == 4);
+
+      std::vector<std::uint64_t> int_mask(16);
+      std::vector<std::uint64_t> double_mask(16);
+      std::vector<std::uint64_t> both(16);
+      std::vector<std::uint64_t> any(16);
+
+      simd::validity(ints, int_mask, target);
+      simd::validity(doubles, double_mask, target);
+      simd::mask_and(int_mask, double_mask, both, target);
+      simd::mask_or(int_mask, double_mask, any, target);
+
+      std::size_t both_count = 0;
+      std::size_t any_count = 0;
+      for (std::size_t i = 0; i < ints.size(); ++i)
+      {
+         const bool lhs = ints[i].has_value();
+         const bool rhs = doubles[i].has_value();
+
+         both_count += ((both[i / 64] >> (i % 64)) & 1U) == (lhs && rhs) ? 1U : 0U;
+         any_count += ((any[i / 64] >> (i % 64)) & 1U) == (lhs || rhs) ? 1U : 0U;
+      }
+
+      CHECK(both_count == ints.size());
+      CHECK(any_count == ints.size());
+   }
+}
+
+namespace
+{
+   constexpr auto parse_digit(char c) -> maybe<int>
+   {
+      return c >= '0' && c <= '9' ? maybe<int>{c - '0'} : maybe<int>{};
+   }
+
+   constexpr auto checked_half(int i) -> result<int, std::errc>
+   {
+      if (i % 2 != 0)
+      {
+         return make_error(std::errc::invalid_argument);
+      }
+
+      return make_value(i / 2);
+   }
+
+   constexpr auto digit_table = [] {
+      std::array<maybe<int>, 128> table{};
+
+      for (std::size_t c = 0; c < table.size(); ++c)
+      {
+         table[c] = parse_digit(static_cast<char>(c));
+      }
+
+      return table;
+   }();
+} // namespace
+
+TEST_CASE("constant evaluation test suite")
+{
+   SUBCASE("maybe")
+   {
+      static_assert(!maybe<int>{}.has_value());
+      static_assert(maybe<int>{1}.value() == 1);
+      static_assert(maybe<int>{1}.map([](int i) { return i + 1; }).value() == 2);
+      static_assert(maybe<int>{2}.and_then(parse_digit).has_value() == false);
+      static_assert(parse_digit('7').and_then([](int i) { return maybe<int>{i * 2}; }).value() ==
+                    14);
+      static_assert(parse_digit('x').value_or(-1) == -1);
+      static_assert(!parse_digit('x').or_else([] {}).has_value());
+      static_assert(user_id{5} == maybe<user_id>{user_id{5}}.value());
+      static_assert(!maybe<double>{}.has_value());
+
+      static_assert([] {
+         maybe<int> m{1};
+         maybe<int> n{};
+         m.swap(n);
+         n = m;
+         return !m.has_value() && !n.has_value();
+      }());
+
+      static_assert([] {
+         maybe<std::string> m{std::string{"constant"}};
+         maybe<std::string> n{m};
+         m = maybe<std::string>{};
+         return !m.has_value() && n.map([](const std::string& s) { return s.size(); }).value() == 8;
+      }());
+
+      static_assert(digit_table['5'].value() == 5);
+      static_assert(!digit_table['a'].has_value());
+   }
+
+   SUBCASE("result")
+   {
+      static_assert(checked_half(4).value() == 2);
+      static_assert(checked_half(3).error() == std::errc::invalid_argument);
+      static_assert(checked_half(8).and_then(checked_half).value() == 2);
+      static_assert(checked_half(6).and_then(checked_half).error() == std::errc::invalid_argument);
+      static_assert(checked_half(4).map([](int i) { return i * 3; }).value() == 6);
+      static_assert(checked_half(4).value_ptr() != nullptr);
+      static_assert(checked_half(4).error_ptr() == nullptr);
+
+      static_assert([] {
+         result<int, std::errc> r = checked_half(1);
+         r = checked_half(2);
+         return r.is_value() && r.value() == 1;
+      }());
+   }
+
+   SUBCASE("either")
+   {
+      using either_type = either<int, double>;
+
+      static_assert(either_type{make_right(1.5)}.right() == 1.5);
+      static_assert(either_type{make_left(2)}.right_map([](double d) { return d * 2; }).left() ==
+                    2);
+      static_assert(either_type{make_right(1.5)}.left_map([](int i) { return i + 1; }).right() ==
+                    1.5);
+      static_assert(either_type{make_left(2)}.left_ptr() != nullptr);
+
+      static_assert([] {
+         either_type e{make_left(1)};
+         e = either_type{make_right(2.0)};
+         return e.is_right() && e.right() == 2.0;
+      }());
+   }
+}
+
+TEST_CASE("pipeline test suite")
+{
+   const auto half = [](int i) -> maybe<int> {
+      return i % 2 == 0 ? maybe<int>{i / 2} : maybe<int>{};
+   };
+
+   SUBCASE("maybe pipeline")
+   {
+      const maybe<int> m{8};
+
+      const maybe<int> halved = pipe(m) | map([](int i) { return i + 4; }) | and_then(half);
+      REQUIRE(halved.has_value());
+      CHECK(halved.value() == 6);
+
+      CHECK((pipe(m) | and_then(half) | and_then(half) | and_then(half) | value_or(-1)) == 1);
+      CHECK((pipe(m) | map([](int i) { return i + 1; }) | and_then(half) | value_or(-1)) == -1);
+      CHECK((pipe(maybe<int>{}) | map([](int i) { return i + 1; }) | value_or(-1)) == -1);
+
+      const auto described =
+         (pipe(m) | map([](int i) { return std::to_string(i); })).run();
+      REQUIRE(described.has_value());
+      CHECK(described.value() == "8");
+   }
+
+   SUBCASE("stages run only on the value")
+   {
+      int calls = 0;
+      const auto count = [&](int i) {
+         ++calls;
+         return i;
+      };
+
+      CHECK((pipe(maybe<int>{3}) | and_then(half) | map(count) | value_or(0)) == 0);
+      CHECK(calls == 0);
+
+      CHECK((pipe(maybe<int>{4}) | map(count) | and_then(half) | map(count) | value_or(0)) == 2);
+      CHECK(calls == 2);
+   }
+
+   SUBCASE("values are moved through the stages")
+   {
+      maybe<std::unique_ptr<int>> m{std::make_unique<int>(3)};
+
+      const auto r = (pipe(std::move(m)) |
+                      map([](std::unique_ptr<int> p) {
+                         *p += 1;
+                         return p;
+                      }) |
+                      map([](std::unique_ptr<int>&& p) { return *p; }))
+                        .run();
+
+      REQUIRE(r.has_value());
+      CHECK(r.value() == 4);
+   }
+
+   SUBCASE("result pipeline")
+   {
+      const auto checked = [](int i) -> result<int, std::string> {
+         if (i < 0)
+         {
+            return make_error(std::string{"negative"});
+         }
+
+         return make_value(i);
+      };
+
+      const result<int, std::string> r{make_value(5)};
+
+      const result<int, std::string> ok =
+         pipe(r) | and_then(checked) | map([](int i) { return i * 2; });
+      REQUIRE(ok.is_value());
+      CHECK(ok.value().value() == 10);
+
+      const result<int, std::string> failed =
+         pipe(r) | map([](int i) { return -i; }) | and_then(checked);
+      REQUIRE(!failed.is_value());
+      CHECK(*failed.error_ptr() == "negative");
+
+      const result<int, std::string> e{make_error(std::string{"source"})};
+      const result<int, std::string> forwarded = pipe(e) | map([](int i) { return i; });
+      CHECK(*forwarded.error_ptr() == "source");
+
+      CHECK((pipe(e) | and_then(checked) | value_or(7)) == 7);
+   }
+
+   SUBCASE("either pipeline")
+   {
+      using parsed = either<std::string, int>;
+
+      const auto positive = [](int i) -> parsed {
+         return i > 0 ? parsed{std::in_place_index<1>, i} : parsed{std::in_place_index<0>, "zero"};
+      };
+
+      const parsed p{std::in_place_index<1>, 2};
+
+      const parsed ok = pipe(p) | map([](int i) { return i * 3; }) | and_then(positive);
+      CHECK(*ok.right_ptr() == 6);
+
+      const parsed failed = pipe(p) | map([](int i) { return i - 2; }) | and_then(positive);
+      CHECK(*failed.left_ptr() == "zero");
+   }
+
+   SUBCASE("constant evaluation")
+   {
+      static_assert((pipe(maybe<int>{2}) | map([](int i) { return i * 10; }) | value_or(0)) ==
+                    20);
+   }
+}
+
+TEST_CASE("in-place construction test suite")
+{
+   SUBCASE("result")
+   {
+      counted::reset_counts();
+
+      result<counted, std::string> by_index{std::in_place_index<0>, 1, 2};
+      REQUIRE(by_index.is_value());
+      CHECK(by_index.value_ptr()->value == 3);
+      CHECK(counted::constructions == 1);
+      CHECK(counted::copies == 0);
+      CHECK(counted::moves == 0);
+
+      counted::reset_counts();
+
+      const result<counted, std::string> by_type{std::in_place_type<counted>, 2, 2};
+      CHECK(by_type.value_ptr()->value == 4);
+      CHECK(counted::constructions == 1);
+      CHECK(counted::copies + counted::moves == 0);
+
+      const result<counted, std::string> error{std::in_place_type<std::string>, 3, 'e'};
+      REQUIRE(!error.is_value());
+      CHECK(*error.error_ptr() == "eee");
+
+      counted::reset_counts();
+
+      by_index.emplace_error("failed");
+      REQUIRE(!by_index.is_value());
+      CHECK(*by_index.error_ptr() == "failed");
+
+      counted& emplaced = by_index.emplace_value(5, 5);
+      REQUIRE(by_index.is_value());
+      CHECK(emplaced.value == 10);
+      CHECK(std::addressof(emplaced) == by_index.value_ptr());
+      CHECK(counted::constructions == 1);
+      CHECK(counted::copies + counted::moves == 0);
+   }
+
+   SUBCASE("either")
+   {
+      counted::reset_counts();
+
+      either<std::string, counted> e{std::in_place_index<1>, 4, 3};
+      REQUIRE(e.is_right());
+      CHECK(e.right_ptr()->value == 7);
+      CHECK(counted::constructions == 1);
+      CHECK(counted::copies + counted::moves == 0);
+
+      e.emplace_left(2, 'l');
+      REQUIRE(!e.is_right());
+      CHECK(*e.left_ptr() == "ll");
+
+      counted::reset_counts();
+
+      e.emplace_right(1, 1);
+      CHECK(e.right_ptr()->value == 2);
+      CHECK(counted::constructions == 1);
+      CHECK(counted::copies + counted::moves == 0);
+
+      using same_type = either<int, int>;
+      CHECK(!std::is_constructible_v<same_type, std::in_place_type_t<int>, int>);
+      CHECK(same_type{std::in_place_index<1>, 3}.is_right());
+   }
+
+   SUBCASE("immovable payload")
+   {
+      result<immovable, int> r{std::in_place_type<immovable>, 3};
+      REQUIRE(r.is_value());
+      CHECK(r.value_ptr()->value == 3);
+
+      r.emplace_error(1);
+      CHECK(!r.is_value());
+
+      const either<int, immovable> e{std::in_place_index<1>, 8};
+      CHECK(e.right_ptr()->value == 8);
+   }
+
+   SUBCASE("maybe and void result")
+   {
+      counted::reset_counts();
+
+      maybe<counted> m{std::in_place, 1, 1};
+      CHECK(m.emplace(2, 3).value == 5);
+      CHECK(counted::constructions == 2);
+      CHECK(counted::copies + counted::moves == 0);
+
+      maybe<double> niche{};
+      CHECK(niche.emplace(2.5) == 2.5);
+      CHECK(niche.has_value());
+
+      maybe<bool> flag{};
+      CHECK(flag.emplace(false) == false);
+      CHECK(flag.has_value());
+
+      result<void, counted> r{};
+      CHECK(r.emplace_error(4, 4).value == 8);
+      REQUIRE(!r.is_value());
+      CHECK(counted::constructions == 3);
+      CHECK(counted::copies + counted::moves == 0);
+
+      result<void, immovable> immovable_error{};
+      CHECK(immovable_error.emplace_error(6).value == 6);
+      CHECK(!immovable_error.is_value());
+
+      fallible::fail = true;
+
+      maybe<fallible> failed{};
+      CHECK_THROWS_AS(failed.emplace(1), std::invalid_argument);
+      CHECK(!failed.has_value());
+
+      fallible::fail = false;
+   }
+
+   SUBCASE("throwing construction")
+   {
+      const result<fallible, std::string> value_source{std::in_place_index<0>, 2};
+      const either<std::string, fallible> right_source{std::in_place_index<1>, 2};
+
+      fallible::fail = true;
+
+      result<fallible, std::string> r{std::in_place_index<1>, "kept"};
+      CHECK_THROWS_AS(r.emplace_value(1), std::invalid_argument);
+      REQUIRE(!r.is_value());
+      CHECK(*r.error_ptr() == "kept");
+
+      either<std::string, fallible> e{std::in_place_index<0>, "kept"};
+      CHECK_THROWS_AS(e.emplace_right(1), std::invalid_argument);
+      REQUIRE(!e.is_right());
+      CHECK(*e.left_ptr() == "kept");
+
+      CHECK_THROWS_AS(r = value_source, std::invalid_argument);
+      REQUIRE(!r.is_value());
+      CHECK(*r.error_ptr() == "kept");
+
+      CHECK_THROWS_AS(e = right_source, std::invalid_argument);
+      REQUIRE(!e.is_right());
+      CHECK(*e.left_ptr() == "kept");
+
+      fallible::fail = false;
+
+      r = value_source;
+      CHECK(r.value_ptr()->value == 2);
+      e = right_source;
+      CHECK(e.right_ptr()->value == 2);
+
+      using throwing_result = result<throwing_move, int>;
+      CHECK(value_emplaceable<throwing_result, int>);
+      CHECK(!value_emplaceable<throwing_result, int, int>);
+
+      using throwing_either = either<int, throwing_move>;
+      CHECK(right_emplaceable<throwing_either, int>);
+      CHECK(!right_emplaceable<throwing_either, int, int>);
+
+      throwing_result t{std::in_place_index<1>, 1};
+      CHECK(t.emplace_value(5).value == 5);
+   }
+
+   SUBCASE("constant evaluation")
+   {
+      static_assert([] {
+         result<int, std::errc> r{std::in_place_index<1>, std::errc::invalid_argument};
+         r.emplace_value(4);
+         return *r.value_ptr();
+      }() == 4);
+   }
+}
+
+TEST_CASE("construct from invocation test suite")
+{
+   const auto make_counted = [](int i) {
+      return counted{i, 1};
+   };
+   const auto make_immovable = [](int i) {
+      return immovable{i};
+   };
+
+   SUBCASE("maybe")
+   {
+      counted::reset_counts();
+
+      const auto m = maybe<int>{2}.map(make_counted);
+      REQUIRE(m.has_value());
+      CHECK(m->value == 3);
+      CHECK(counted::constructions == 1);
+      CHECK(counted::copies + counted::moves == 0);
+
+      const auto i = maybe<int>{4}.map(make_immovable);
+      REQUIRE(i.has_value());
+      CHECK(i->value == 4);
+
+      int target = 1;
+      const auto r = maybe<int>{0}.map([&](int) -> int& { return target; });
+      REQUIRE(r.has_value());
+      CHECK(&r.value() == &target);
+   }
+
+   SUBCASE("result")
+   {
+      counted::reset_counts();
+
+      const auto mapped = result<int, int>{make_value(5)}.map(make_counted);
+      REQUIRE(mapped.is_value());
+      CHECK(mapped.value_ptr()->value == 6);
+      CHECK(counted::constructions == 1);
+      CHECK(counted::copies + counted::moves == 0);
+
+      const auto errored = result<int, int>{make_error(7)}.map_error(make_counted);
+      REQUIRE(!errored.is_value());
+      CHECK(errored.error_ptr()->value == 8);
+      CHECK(counted::constructions == 2);
+      CHECK(counted::copies + counted::moves == 0);
+
+      const result<int, counted> failed{std::in_place_index<1>, 1, 1};
+      counted::reset_counts();
+
+      const auto propagated = failed.and_then([](int i) -> result<std::string, counted> {
+         return make_value(std::to_string(i));
+      });
+      REQUIRE(!propagated.is_value());
+      CHECK(propagated.error_ptr()->value == 2);
+      CHECK(counted::copies == 1);
+      CHECK(counted::moves == 0);
+
+      const auto i = result<int, int>{make_value(9)}.map(make_immovable);
+      CHECK(i.value_ptr()->value == 9);
+   }
+
+   SUBCASE("either")
+   {
+      counted::reset_counts();
+
+      const auto left = either<int, int>{make_left(1)}.left_map(make_counted);
+      REQUIRE(!left.is_right());
+      CHECK(left.left_ptr()->value == 2);
+
+      const auto right = either<int, int>{make_right(2)}.right_map(make_counted);
+      REQUIRE(right.is_right());
+      CHECK(right.right_ptr()->value == 3);
+
+      CHECK(counted::constructions == 2);
+      CHECK(counted::copies + counted::moves == 0);
+
+      const auto i = either<int, int>{make_right(3)}.right_map(make_immovable);
+      CHECK(i.right_ptr()->value == 3);
+   }
+}
+
+namespace
+{
+   struct rich_error
+   {
+      int code{0};
+      std::array<char, 192> context{};
+
+      constexpr auto operator==(const rich_error&) const -> bool = default;
+   };
+} // namespace
+
+TEST_CASE("boxed error test suite")
+{
+   static_assert(sizeof(result<int, rich_error>) > sizeof(rich_error));
+   static_assert(sizeof(result<int, boxed<rich_error>>) == sizeof(result<int, void*>));
+   static_assert(!std::is_trivially_copyable_v<result<int, boxed<rich_error>>>);
+
+   SUBCASE("value and error")
+   {
+      const result<int, boxed<rich_error>> ok{make_value(1)};
+      REQUIRE(ok.is_value());
+      CHECK(*ok.value_ptr() == 1);
+
+      const result<int, boxed<rich_error>> failed{make_boxed_error(rich_error{.code = 42})};
+      REQUIRE(!failed.is_value());
+      CHECK((*failed.error_ptr())->code == 42);
+
+      const result<int, boxed<rich_error>> in_place{std::in_place_index<1>, rich_error{.code = 7}};
+      CHECK((*in_place.error_ptr())->code == 7);
+
+      const auto mapped = failed.map_error([](const boxed<rich_error>& e) { return e->code; });
+      CHECK(*mapped.error_ptr() == 42);
+   }
+
+   SUBCASE("copy and move")
+   {
+      result<int, boxed<rich_error>> failed{make_boxed_error(rich_error{.code = 3})};
+
+      const auto copy = failed;
+      REQUIRE(!copy.is_value());
+      CHECK(copy.error_ptr()->get() != failed.error_ptr()->get());
+      CHECK(*copy.error_ptr() == *failed.error_ptr());
+
+      const auto* box = failed.error_ptr()->get();
+      const auto moved = std::move(failed);
+      CHECK(moved.error_ptr()->get() == box);
+   }
+
+   SUBCASE("blocks are reused")
+   {
+      const void* first = nullptr;
+      {
+         const boxed<rich_error> e{rich_error{.code = 1}};
+         first = e.get();
+      }
+
+      const boxed<rich_error> e{rich_error{.code = 2}};
+      CHECK(e.get() == first);
+
+      using pool = detail::block_pool<sizeof(rich_error), alignof(rich_error)>;
+
+      const std::size_t chunks = pool::chunk_count();
+
+      std::vector<boxed<rich_error>> burst;
+      for (int i = 0; i < 1000; ++i)
+      {
+         burst.emplace_back(rich_error{.code = i});
+      }
+      burst.clear();
+
+      const std::size_t after_burst = pool::chunk_count();
+      CHECK(after_burst > chunks);
+
+      for (int i = 0; i < 1000; ++i)
+      {
+         burst.emplace_back(rich_error{.code = i});
+      }
+
+      CHECK(pool::chunk_count() == after_burst);
+      CHECK(burst[999]->code == 999);
+   }
+}
+
+TEST_CASE("result void test suite")
+{
+   enum class io_error : std::uint8_t
+   {
+      closed,
+      timeout
+   };
+
+   static_assert(sizeof(result<void, std::errc>) == sizeof(maybe<std::errc>));
+   static_assert(sizeof(result<void, colour>) == sizeof(colour));
+   static_assert(std::is_trivially_copyable_v<result<void, std::errc>>);
+
+   const auto write = [](bool ok) -> result<void, std::errc> {
+      if (!ok)
+      {
+         return make_error(std::errc::io_error);
+      }
+
+      return make_value();
+   };
+
+   SUBCASE("construction")
+   {
+      const result<void, std::errc> success{};
+      CHECK(success.is_value());
+      CHECK(success.error_ptr() == nullptr);
+
+      const result<void, std::errc> failure{std::in_place_index<1>, std::errc::timed_out};
+      REQUIRE(!failure.is_value());
+      CHECK(*failure.error_ptr() == std::errc::timed_out);
+      CHECK(failure.error().value() == std::errc::timed_out);
+
+      result<void, std::string> r{};
+      r.emplace_error("broken pipe");
+      CHECK(*r.error_ptr() == "broken pipe");
+      r.emplace_value();
+      CHECK(r.is_value());
+   }
+
+   SUBCASE("nullary continuations")
+   {
+      int flushed = 0;
+      const auto flush = [&]() -> result<void, std::errc> {
+         ++flushed;
+         return {};
+      };
+
+      CHECK(write(true).and_then(flush).is_value());
+      CHECK(flushed == 1);
+
+      CHECK(*write(false).and_then(flush).error_ptr() == std::errc::io_error);
+      CHECK(flushed == 1);
+
+      const auto size = write(true).and_then([]() -> result<int, std::errc> {
+         return make_value(3);
+      });
+      CHECK(*size.value_ptr() == 3);
+
+      CHECK(*write(true).map([] { return 4; }).value_ptr() == 4);
+      CHECK(*write(false).map([] { return 4; }).error_ptr() == std::errc::io_error);
+
+      const result<int, std::errc> parsed{make_value(1)};
+      const result<void, std::errc> discarded = parsed.map([](int) {});
+      CHECK(discarded.is_value());
+   }
+
+   SUBCASE("fallbacks")
+   {
+      CHECK(write(true).error_or(std::errc::interrupted) == std::errc::interrupted);
+      CHECK(write(false).error_or(std::errc::interrupted) == std::errc::io_error);
+
+      CHECK(write(true).map_or([] { return 1; }, 0) == 1);
+      CHECK(write(false).map_or([] { return 1; }, 0) == 0);
+
+      CHECK(write(false).join([] { return 0; }, [](std::errc e) { return static_cast<int>(e); }) ==
+            static_cast<int>(std::errc::io_error));
+
+      const auto recovered =
+         write(false).or_else([](std::errc) -> result<void, io_error> { return {}; });
+      CHECK(recovered.is_value());
+
+      const auto translated = write(false).map_error([](std::errc) { return io_error::closed; });
+      CHECK(*translated.error_ptr() == io_error::closed);
+   }
+
+   SUBCASE("constant evaluation")
+   {
+      static_assert(result<void, int>{}.is_value());
+      static_assert(result<void, int>{make_error(3)}.error_or(0) == 3);
+   }
+}
+
+TEST_CASE("sum test suite")
+{
+   using monad::sum;
+
+   using shape = sum<std::uint8_t, std::uint16_t, std::uint32_t>;
+
+   SUBCASE("layout")
+   {
+      static_assert(sizeof(shape) == 2 * sizeof(std::uint32_t));
+      static_assert(std::is_trivially_copyable_v<shape>);
+      static_assert(std::is_trivially_destructible_v<shape>);
+      static_assert(!std::is_trivially_copyable_v<sum<int, std::string>>);
+   }
+
+   SUBCASE("construction")
+   {
+      const shape by_index{std::in_place_index<1>, std::uint16_t{7}};
+      CHECK(by_index.index() == 1);
+      CHECK(by_index.holds<std::uint16_t>());
+
+      const shape by_type{std::in_place_type<std::uint32_t>, 9U};
+      CHECK(by_type.index() == 2);
+
+      const shape by_value = std::uint8_t{3};
+      CHECK(by_value.holds<0>());
+
+      const shape by_default{};
+      CHECK(by_default.index() == 0);
+      CHECK(*by_default.get_ptr<0>() == 0);
+   }
+
+   SUBCASE("access")
+   {
+      const shape s{std::in_place_index<2>, 42U};
+      CHECK(s.get<2>().value_or(0U) == 42U);
+      CHECK(!s.get<1>().has_value());
+      CHECK(s.get_ptr<0>() == nullptr);
+      CHECK(*s.get_ptr<2>() == 42U);
+   }
+
+   SUBCASE("match and join")
+   {
+      const shape s{std::in_place_index<1>, std::uint16_t{5}};
+
+      CHECK(s.match([](auto value) { return sizeof(value); }) == sizeof(std::uint16_t));
+      CHECK(s.join([](std::uint8_t) { return 0; }, [](std::uint16_t v) { return v + 1; },
+                   [](std::uint32_t) { return 2; }) == 6);
+
+      sum<int, std::string> text{std::in_place_index<1>, "long enough to allocate on the heap"};
+      const auto moved = std::move(text).match([](auto&& value) {
+         using value_type = std::remove_cvref_t<decltype(value)>;
+         if constexpr (std::is_same_v<value_type, std::string>)
+         {
+            return std::string{std::move(value)};
+         }
+         else
+         {
+            return std::to_string(value);
+         }
+      });
+      CHECK(moved == "long enough to allocate on the heap");
+   }
+
+   SUBCASE("many alternatives")
+   {
+      using wide = sum<char, signed char, unsigned char, short, unsigned short, int, unsigned,
+                       long, unsigned long, long long, double>;
+
+      const auto width = [](auto value) { return sizeof(value); };
+
+      static_assert(wide{std::in_place_index<10>, 1.0}.match(width) == sizeof(double));
+      CHECK(wide{std::in_place_index<9>, 1LL}.match(width) == sizeof(long long));
+      CHECK(wide{std::in_place_index<2>, 'a'}.match(width) == 1);
+
+      wide copy{wide{std::in_place_type<unsigned long>, 5UL}};
+      CHECK(*copy.get_ptr<8>() == 5UL);
+   }
+
+   SUBCASE("non trivial alternatives")
+   {
+      counted::reset_counts();
+
+      sum<int, counted> s{std::in_place_index<1>, 1, 2};
+      sum<int, counted> copy{s};
+      const sum<int, counted> moved{std::move(s)};
+      CHECK(counted::constructions == 1);
+      CHECK(counted::copies == 1);
+      CHECK(counted::moves == 1);
+
+      copy.emplace<0>(4);
+      CHECK(*copy.get_ptr<0>() == 4);
+
+      copy = moved;
+      CHECK(copy.get_ptr<1>()->value == 3);
+      CHECK(counted::copies == 2);
+   }
+
+   SUBCASE("throwing construction")
+   {
+      sum<std::string, fallible> s{std::in_place_index<0>, "kept"};
+      const sum<std::string, fallible> source{std::in_place_index<1>, 2};
+
+      fallible::fail = true;
+
+      CHECK_THROWS_AS(s.emplace<1>(1), std::invalid_argument);
+      REQUIRE(s.holds<0>());
+      CHECK(*s.get_ptr<0>() == "kept");
+
+      CHECK_THROWS_AS(s = source, std::invalid_argument);
+      REQUIRE(s.holds<0>());
+      CHECK(*s.get_ptr<0>() == "kept");
+
+      fallible::fail = false;
+
+      s = source;
+      CHECK(s.get_ptr<1>()->value == 2);
+
+      using throwing_sum = sum<int, throwing_move>;
+      CHECK(std::is_nothrow_copy_assignable_v<throwing_sum>);
+      CHECK(std::is_nothrow_move_assignable_v<throwing_sum>);
+
+      throwing_sum t{std::in_place_index<0>, 1};
+      CHECK(t.emplace<1>(4).value == 4);
+   }
+
+   SUBCASE("constant evaluation")
+   {
+      static_assert(shape{std::in_place_index<2>, 4U}.match([](auto v) { return int(v); }) == 4);
+      static_assert([] {
+         sum<int, std::string> s{std::in_place_index<1>, "text"};
+         s.emplace<0>(3);
+         return s.join([](int v) { return v; },
+                       [](const std::string& v) { return static_cast<int>(v.size()); });
+      }() == 3);
+   }
+}
+
+TEST_CASE("traverse test suite")
+{
+   const auto half = [](int i) -> result<int, std::string> {
+      if (i % 2 != 0)
+      {
+         return make_error("odd " + std::to_string(i));
+      }
+
+      return make_value(i / 2);
+   };
+
+   SUBCASE("sequence")
+   {
+      const std::vector<maybe<int>> full{maybe<int>{1}, maybe<int>{2}, maybe<int>{3}};
+      const auto values = sequence(full);
+      REQUIRE(values.has_value());
+      CHECK(values.value() == std::vector<int>{1, 2, 3});
+
+      const std::vector<maybe<int>> holed{maybe<int>{1}, maybe<int>{}, maybe<int>{3}};
+      CHECK(!sequence(holed).has_value());
+
+      const std::vector<result<int, std::string>> results{
+         make_value(1), make_error(std::string{"bad"}), make_error(std::string{"worse"})};
+      CHECK(*sequence(results).error_ptr() == "bad");
+
+      const std::vector<either<int, char>> eithers{either<int, char>{std::in_place_index<1>, 'a'},
+                                                   either<int, char>{std::in_place_index<1>, 'b'}};
+      CHECK(*sequence(eithers).right_ptr() == std::vector<char>{'a', 'b'});
+
+      CHECK(sequence(std::vector<maybe<int>>{}).value().empty());
+   }
+
+   SUBCASE("traverse")
+   {
+      const std::vector<int> evens{2, 4, 6};
+      CHECK(*traverse(evens, half).value_ptr() == std::vector<int>{1, 2, 3});
+
+      int calls = 0;
+      const std::vector<int> mixed{2, 3, 4, 5};
+      const auto failed = traverse(mixed, [&](int i) {
+         ++calls;
+         return half(i);
+      });
+      CHECK(*failed.error_ptr() == "odd 3");
+      CHECK(calls == 2);
+   }
+
+   SUBCASE("unsized ranges")
+   {
+      const std::vector<int> numbers{1, 2, 3, 4, 5, 6};
+      auto evens = numbers | std::views::filter([](int i) { return i % 2 == 0; });
+      static_assert(!std::ranges::sized_range<decltype(evens)>);
+
+      CHECK(*traverse(evens, half).value_ptr() == std::vector<int>{1, 2, 3});
+   }
+
+   SUBCASE("rvalue ranges are moved from")
+   {
+      std::vector<maybe<counted>> source;
+      source.emplace_back(std::in_place, 1, 2);
+      source.emplace_back(std::in_place, 3, 4);
+
+      counted::reset_counts();
+
+      const auto borrowed = sequence(source);
+      CHECK(counted::copies == 2);
+
+      const auto moved = sequence(std::move(source));
+      CHECK(counted::copies == 2);
+      CHECK(counted::moves == 2);
+      CHECK(moved.value()[1].value == 7);
+      CHECK(borrowed.value()[0].value == 3);
+   }
+
+   SUBCASE("constant evaluation")
+   {
+      static_assert([] {
+         const std::vector<maybe<int>> values{maybe<int>{1}, maybe<int>{2}};
+         return sequence(values).value().size();
+      }() == 2);
+   }
+}
+
+TEST_CASE("parallel traverse test suite")
+{
+   using monad::par;
+   using monad::par_policy;
+
+   std::vector<int> inputs(10000);
+   std::iota(inputs.begin(), inputs.end(), 0);
+
+   const auto square = [](int i) -> result<long, std::string> {
+      if (i < 0)
+      {
+         return make_error("negative " + std::to_string(i));
+      }
+
+      return make_value(static_cast<long>(i) * i);
+   };
+
+   SUBCASE("values keep the order of the input")
+   {
+      const auto squares = par_traverse(par_policy{.workers = 4, .chunk_size = 7}, inputs, square);
+      REQUIRE(squares.is_value());
+      REQUIRE(squares.value_ptr()->size() == inputs.size());
+      CHECK((*squares.value_ptr())[9999] == 9999L * 9999L);
+      CHECK(*traverse(inputs, square).value_ptr() == *squares.value_ptr());
+
+      CHECK(par_traverse(par, std::vector<int>{}, square).value_ptr()->empty());
+   }
+
+   SUBCASE("the lowest failing index wins")
+   {
+      inputs[7000] = -2;
+      inputs[300] = -1;
+      inputs[9000] = -3;
+
+      for (std::size_t workers = 1; workers <= 8; workers *= 2)
+      {
+         const auto failed = par_traverse(par_policy{.workers = workers, .chunk_size = 16}, inputs,
+                                          square);
+         REQUIRE(!failed.is_value());
+         CHECK(*failed.error_ptr() == "negative -1");
+      }
+   }
+
+   SUBCASE("work past a failure is skipped")
+   {
+      std::atomic<int> calls{0};
+      inputs[0] = -1;
+
+      const auto failed = par_traverse(par_policy{.workers = 1}, inputs, [&](int i) {
+         ++calls;
+         return square(i);
+      });
+      CHECK(*failed.error_ptr() == "negative -1");
+      CHECK(calls == 1);
+   }
+
+   SUBCASE("exceptions reach the caller")
+   {
+      const auto throwing = [](int i) -> result<int, int> {
+         if (i == 500)
+         {
+            throw std::runtime_error{"validator"};
+         }
+
+         return make_value(i);
+      };
+
+      CHECK_THROWS_AS(par_traverse(par_policy{.workers = 4}, inputs, throwing),
+                      std::runtime_error);
+   }
+}
+
+namespace
+{
+   auto halve(int i) -> maybe<int>
+   {
+      return i % 2 == 0 ? maybe<int>{i / 2} : maybe<int>{};
+   }
+
+   auto quarter(int i) -> maybe<int>
+   {
+      const int half = co_await halve(i);
+      co_return co_await halve(half);
+   }
+
+   auto read_digit(char c) -> result<int, std::string>
+   {
+      if (c < '0' || c > '9')
+      {
+         return make_error(std::string{"not a digit: "} + c);
+      }
+
+      return make_value(c - '0');
+   }
+
+   auto parse_pair(std::string_view text) -> result<int, std::string>
+   {
+      const int tens = co_await read_digit(text[0]);
+      const int units = co_await read_digit(text[1]);
+
+      co_return tens * 10 + units;
+   }
+
+   auto check_digits(std::string_view text) -> result<void, std::string>
+   {
+      for (const char c : text)
+      {
+         co_await read_digit(c);
+      }
+   }
+
+   struct scope_counter
+   {
+      explicit scope_counter(int& counter) : destroyed{counter} {}
+      scope_counter(const scope_counter&) = delete;
+      scope_counter(scope_counter&&) = delete;
+      ~scope_counter() { ++destroyed; }
+
+      auto operator=(const scope_counter&) -> scope_counter& = delete;
+      auto operator=(scope_counter&&) -> scope_counter& = delete;
+
+      int& destroyed;
+   };
+
+   auto guarded(int& destroyed, int i) -> maybe<int>
+   {
+      const scope_counter guard{destroyed};
+
+      co_return co_await halve(i);
+   }
+
+   auto arena_digit(const monad::coroutine_arena& arena, char c, std::size_t& used)
+      -> result<int, std::string>
+   {
+      used = arena.used();
+
+      co_return co_await read_digit(c);
+   }
+} // namespace
+
+TEST_CASE("coroutine test suite")
+{
+   SUBCASE("maybe")
+   {
+      CHECK(quarter(12).value_or(-1) == 3);
+      CHECK(!quarter(6).has_value());
+      CHECK(!quarter(7).has_value());
+   }
+
+   SUBCASE("result")
+   {
+      CHECK(*parse_pair("42").value_ptr() == 42);
+      CHECK(*parse_pair("4x").error_ptr() == "not a digit: x");
+      CHECK(*parse_pair("y2").error_ptr() == "not a digit: y");
+
+      CHECK(check_digits("123").is_value());
+      CHECK(*check_digits("1a3").error_ptr() == "not a digit: a");
+   }
+
+   SUBCASE("locals are destroyed on early return")
+   {
+      int destroyed = 0;
+
+      CHECK(guarded(destroyed, 4).value_or(0) == 2);
+      CHECK(destroyed == 1);
+
+      CHECK(!guarded(destroyed, 5).has_value());
+      CHECK(destroyed == 2);
+   }
+
+   SUBCASE("frames come from the arena")
+   {
+      std::array<std::byte, 1024> buffer{};
+      monad::coroutine_arena arena{buffer};
+      const monad::coroutine_arena::scope scope{arena};
+
+      for (const char c : {'1', '2', 'z'})
+      {
+         std::size_t used = 0;
+         const auto digit = arena_digit(arena, c, used);
+
+         CHECK(used > 0);
+         CHECK(arena.used() == 0);
+         CHECK(digit.is_value() == (c != 'z'));
+      }
+   }
+
+   SUBCASE("exceptions propagate to the caller")
+   {
+      const auto throwing = []() -> maybe<int> {
+         co_await halve(2);
+         throw std::runtime_error{"coroutine"};
+      };
+
+      CHECK_THROWS_AS(throwing(), std::runtime_error);
+   }
+}
+
+namespace
+{
+   struct parse_failure
+   {
+      std::string input;
+   };
+
+   struct range_failure
+   {
+      int value;
+   };
+
+   auto parse_positive(const std::string& text) -> int
+   {
+      if (text.empty() || text[0] < '0' || text[0] > '9')
+      {
+         throw parse_failure{text};
+      }
+
+      const int value = std::stoi(text);
+      if (value == 0)
+      {
+         throw range_failure{value};
+      }
+
+      return value;
+   }
+} // namespace
+
+TEST_CASE("try wrap test suite")
+{
+   SUBCASE("single exception type")
+   {
+      const auto ok = try_wrap<parse_failure>(parse_positive, std::string{"12"});
+      CHECK(*ok.value_ptr() == 12);
+
+      const auto failed = try_wrap<parse_failure>(parse_positive, std::string{"x"});
+      CHECK(failed.error_ptr()->input == "x");
+
+      CHECK_THROWS_AS(try_wrap<parse_failure>(parse_positive, std::string{"0"}), range_failure);
+   }
+
+   SUBCASE("noexcept functions skip the handler")
+   {
+      const auto twice = [](int i) noexcept { return i * 2; };
+
+      CHECK(*try_wrap<std::exception>(twice, 4).value_ptr() == 8);
+   }
+
+   SUBCASE("callables are forwarded")
+   {
+      int calls = 0;
+      auto counter = [calls]() mutable { return ++calls; };
+
+      CHECK(*try_wrap<std::exception>(counter).value_ptr() == 1);
+      CHECK(*try_wrap<std::exception>(counter).value_ptr() == 2);
+
+      auto owner = [p = std::make_unique<int>(5)]() mutable { return std::move(p); };
+      const auto moved = try_wrap<std::exception>(std::move(owner));
+      CHECK(**moved.value_ptr() == 5);
+
+      int touched = 0;
+      CHECK(try_wrap<std::exception>([&] { ++touched; }).is_value());
+      CHECK(touched == 1);
+   }
+
+   SUBCASE("several exception types into a sum")
+   {
+      using error = monad::sum<parse_failure, range_failure>;
+
+      const auto parse = [](const std::string& text) {
+         return try_wrap<error>(parse_positive, text);
+      };
+
+      CHECK(*parse("7").value_ptr() == 7);
+      CHECK(parse("x").error_ptr()->get_ptr<0>()->input == "x");
+      CHECK(parse("0").error_ptr()->get_ptr<1>()->value == 0);
+   }
+
+   SUBCASE("caught exceptions are moved")
+   {
+      const auto throw_counted = []() -> int { throw counted{1, 2}; };
+
+      counted::reset_counts();
+      const auto failed = try_wrap<counted>(throw_counted);
+      CHECK(failed.error_ptr()->value == 3);
+      CHECK(counted::copies == 0);
+   }
+
+   SUBCASE("translator")
+   {
+      const auto translate = [](auto&& e) -> std::string {
+         if constexpr (std::is_same_v<std::remove_cvref_t<decltype(e)>, parse_failure>)
+         {
+            return "parse: " + std::move(e.input);
+         }
+         else
+         {
+            return "range: " + std::to_string(e.value);
+         }
+      };
+
+      const auto parse = [&](const std::string& text) {
+         return try_translate<parse_failure, range_failure>(translate, parse_positive, text);
+      };
+
+      CHECK(*parse("3").value_ptr() == 3);
+      CHECK(*parse("q").error_ptr() == "parse: q");
+      CHECK(*parse("0").error_ptr() == "range: 0");
+   }
+}
+
+TEST_CASE("branch likelihood test suite")
+{
+   SUBCASE("errors are forwarded out of line")
+   {
+      using counted_result = result<int, counted>;
+
+      const auto twice = [](int i) { return i * 2; };
+      const auto checked = [](int i) -> counted_result { return make_value(i + 1); };
+
+      counted::reset_counts();
+      counted_result failed{std::in_place_index<1>, 1, 2};
+      const auto mapped = std::move(failed).map(twice).and_then(checked);
+      CHECK(mapped.error_ptr()->value == 3);
+      CHECK(counted::constructions == 1);
+      CHECK(counted::copies == 0);
+      CHECK(counted::moves == 2);
+
+      counted::reset_counts();
+      const counted_result kept{std::in_place_index<1>, 2, 2};
+      CHECK(kept.map(twice).and_then(checked).error_ptr()->value == 4);
+      CHECK(counted::copies == 1);
+   }
+
+   SUBCASE("values take the likely branch")
+   {
+      const result<int, std::string> ok = make_value(4);
+
+      CHECK(*ok.map([](int i) { return i + 1; }).value_ptr() == 5);
+      CHECK(maybe<int>{4}.and_then([](int i) { return maybe<int>{i * 3}; }).value_or(0) == 12);
+   }
+}
+
+namespace
+{
+   /**
+    * A file in the temporary directory, removed when the guard goes out of scope
+    */
+   struct temporary_file
+   {
+      explicit temporary_file(const char* name) :
+         path{(std::filesystem::temp_directory_path() / name).string()}
+      {}
+      temporary_file(const temporary_file&) = delete;
+      temporary_file(temporary_file&&) = delete;
+      ~temporary_file() { std::filesystem::remove(path); }
+
+      auto operator=(const temporary_file&) -> temporary_file& = delete;
+      auto operator=(temporary_file&&) -> temporary_file& = delete;
+
+      std::string path;
+   };
+} // namespace
+
+TEST_CASE("binary layout test suite")
+{
+   SUBCASE("tag placement")
+   {
+      using outcome = result<std::int32_t, std::errc>;
+
+      std::array<std::byte, sizeof(outcome)> bytes{};
+      const std::array<outcome, 1> failed{outcome{make_error(std::errc::timed_out)}};
+      to_binary(failed, bytes);
+
+      CHECK(binary_layout<outcome>::tag_offset == 4);
+      CHECK(bytes[4] == std::byte{1});
+
+      auto code = std::errc{};
+      std::memcpy(&code, bytes.data(), sizeof(code));
+      CHECK(code == std::errc::timed_out);
+
+      const std::array<maybe<std::int16_t>, 1> empty{};
+      std::array<std::byte, sizeof(maybe<std::int16_t>)> cleared{std::byte{0xFF}, std::byte{0xFF},
+                                                                 std::byte{0xFF}, std::byte{0xFF}};
+      to_binary(empty, cleared);
+      CHECK(cleared == std::array<std::byte, 4>{});
+   }
+
+   SUBCASE("round trip through a mapped file")
+   {
+      const temporary_file file{"monads_binary_round_trip.bin"};
+
+      std::vector<result<std::int64_t, std::errc>> outcomes;
+      for (std::int64_t i = 0; i < 10000; ++i)
+      {
+         if (i % 7 == 0)
+         {
+            outcomes.emplace_back(make_error(std::errc::invalid_argument));
+         }
+         else
+         {
+            outcomes.emplace_back(make_value(i));
+         }
+      }
+
+      REQUIRE(write_binary(file.path.c_str(), outcomes).is_value());
+
+      auto mapped = mapped_array<result<std::int64_t, std::errc>>::open(file.path.c_str(),
+                                                                         binary_check::tags);
+      REQUIRE(mapped.is_value());
+      REQUIRE(mapped.value_ptr()->size() == outcomes.size());
+
+      bool same = true;
+      for (std::size_t i = 0; i < outcomes.size(); ++i)
+      {
+         const auto& read = (*mapped.value_ptr())[i];
+         same = same && read.is_value() == outcomes[i].is_value() &&
+            (read.is_value() ? *read.value_ptr() == *outcomes[i].value_ptr()
+                             : *read.error_ptr() == *outcomes[i].error_ptr());
+      }
+      CHECK(same);
+   }
+
+   SUBCASE("maybe and either")
+   {
+      const temporary_file maybes{"monads_binary_maybe.bin"};
+      const temporary_file eithers{"monads_binary_either.bin"};
+
+      const std::array<maybe<colour>, 3> colours{maybe<colour>{colour::blue}, maybe<colour>{},
+                                                 maybe<colour>{colour::red}};
+      const std::array<either<float, std::uint16_t>, 2> sides{make_left(1.5F),
+                                                             make_right(std::uint16_t{7})};
+
+      REQUIRE(write_binary(maybes.path.c_str(), colours).is_value());
+      REQUIRE(write_binary(eithers.path.c_str(), sides).is_value());
+
+      const auto read_colours = mapped_array<maybe<colour>>::open(maybes.path.c_str());
+      REQUIRE(read_colours.is_value());
+      const auto& read = *read_colours.value_ptr();
+      REQUIRE(read.size() == 3);
+      CHECK(read[0].value_or(colour::green) == colour::blue);
+      CHECK_FALSE(read[1].has_value());
+      CHECK(read[2].value_or(colour::green) == colour::red);
+
+      const auto read_sides =
+         mapped_array<either<float, std::uint16_t>>::open(eithers.path.c_str());
+      REQUIRE(read_sides.is_value());
+      CHECK(*(*read_sides.value_ptr())[0].left_ptr() == 1.5F);
+      CHECK(*(*read_sides.value_ptr())[1].right_ptr() == 7);
+   }
+
+   SUBCASE("mismatched files are rejected")
+   {
+      const temporary_file file{"monads_binary_mismatch.bin"};
+
+      const std::array<maybe<std::int32_t>, 2> values{maybe<std::int32_t>{1},
+                                                      maybe<std::int32_t>{2}};
+      REQUIRE(write_binary(file.path.c_str(), values).is_value());
+
+      CHECK(*mapped_array<maybe<std::int64_t>>::open(file.path.c_str()).error_ptr() ==
+            std::errc::invalid_argument);
+      CHECK(*mapped_array<result<std::int32_t, std::int32_t>>::open(file.path.c_str())
+                .error_ptr() == std::errc::invalid_argument);
+      CHECK(*mapped_array<maybe<std::int32_t>>::open("/nonexistent/monads.bin").error_ptr() ==
+            std::errc::no_such_file_or_directory);
+
+      std::filesystem::resize_file(file.path, std::filesystem::file_size(file.path) - 1);
+      CHECK(*mapped_array<maybe<std::int32_t>>::open(file.path.c_str()).error_ptr() ==
+            std::errc::invalid_argument);
+   }
+}
+
+namespace
+{
+   /**
+    * A memory resource counting the allocations it passes on to the global heap
+    */
+   class counting_resource : public std::pmr::memory_resource
+   {
+   public:
+      std::size_t allocations = 0;
+
+   private:
+      auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override
+      {
+         ++allocations;
+
+         return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+      }
+      void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override
+      {
+         std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+      }
+      auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override
+      {
+         return this == &other;
+      }
+   };
+
+   /**
+    * Counts the allocations made from the default memory resource while in scope
+    */
+   struct default_resource_guard
+   {
+      default_resource_guard() : previous{std::pmr::set_default_resource(&counter)} {}
+      default_resource_guard(const default_resource_guard&) = delete;
+      default_resource_guard(default_resource_guard&&) = delete;
+      ~default_resource_guard() { std::pmr::set_default_resource(previous); }
+
+      auto operator=(const default_resource_guard&) -> default_resource_guard& = delete;
+      auto operator=(default_resource_guard&&) -> default_resource_guard& = delete;
+
+      counting_resource counter;
+      std::pmr::memory_resource* previous;
+   };
+
+   /**
+    * A request arena that fails instead of falling back to the heap
+    */
+   struct request_arena
+   {
+      std::array<std::byte, 4096> buffer{};
+      std::pmr::monotonic_buffer_resource resource{buffer.data(), buffer.size(),
+                                                   std::pmr::null_memory_resource()};
+   };
+} // namespace
+
+TEST_CASE("allocator propagation test suite")
+{
+   using text = std::pmr::string;
+   using allocator = std::pmr::polymorphic_allocator<>;
+
+   static_assert(std::uses_allocator_v<result<text, std::errc>, allocator>);
+   static_assert(std::uses_allocator_v<result<void, text>, allocator>);
+   static_assert(std::uses_allocator_v<either<std::errc, text>, allocator>);
+   static_assert(std::uses_allocator_v<maybe<text>, allocator>);
+   static_assert(!std::uses_allocator_v<result<int, std::errc>, allocator>);
+   static_assert(!std::uses_allocator_v<maybe<std::string>, allocator>);
+
+   constexpr const char* long_text = "a payload too long for the small string buffer";
+
+   SUBCASE("allocator-extended construction")
+   {
+      request_arena arena;
+      const allocator alloc{&arena.resource};
+
+      const result<text, text> value{std::allocator_arg, alloc, std::in_place_index<0>, long_text};
+      const result<text, text> copy{std::allocator_arg, alloc, value};
+      const result<void, text> failed{std::allocator_arg, alloc, make_error(text{long_text})};
+      const either<std::errc, text> right{std::allocator_arg, alloc, make_right(text{long_text})};
+      const maybe<text> some{std::allocator_arg, alloc, std::in_place, long_text};
+
+      CHECK(*copy.value_ptr() == long_text);
+      CHECK(value.value_ptr()->get_allocator().resource() == &arena.resource);
+      CHECK(copy.value_ptr()->get_allocator().resource() == &arena.resource);
+      CHECK(failed.error_ptr()->get_allocator().resource() == &arena.resource);
+      CHECK(right.right_ptr()->get_allocator().resource() == &arena.resource);
+      CHECK(some->get_allocator().resource() == &arena.resource);
+   }
+
+   SUBCASE("containers build their elements with their allocator")
+   {
+      request_arena arena;
+
+      std::pmr::vector<result<text, std::errc>> outcomes{&arena.resource};
+      outcomes.reserve(3);
+      outcomes.emplace_back(std::in_place_index<0>, long_text);
+      outcomes.emplace_back(make_error(std::errc::timed_out));
+      outcomes.push_back(outcomes.front());
+
+      std::pmr::vector<maybe<text>> maybes{&arena.resource};
+      maybes.reserve(2);
+      maybes.emplace_back(std::in_place, long_text);
+      maybes.emplace_back(none);
+
+      CHECK(outcomes[0].value_ptr()->get_allocator().resource() == &arena.resource);
+      CHECK(outcomes[1].error_ptr() != nullptr);
+      CHECK(outcomes[2].value_ptr()->get_allocator().resource() == &arena.resource);
+      CHECK(maybes[0]->get_allocator().resource() == &arena.resource);
+      CHECK(!maybes[1].has_value());
+   }
+
+   SUBCASE("a pipeline makes no global allocation")
+   {
+      using outcome = result<text, text>;
+
+      request_arena arena;
+      const allocator alloc{&arena.resource};
+      const default_resource_guard guard;
+
+      const auto annotate = [](const text& body) {
+         text annotated{body, body.get_allocator()};
+         annotated += " annotated";
+
+         return annotated;
+      };
+      const auto validate = [](const text& body) -> outcome {
+         return {std::allocator_arg, body.get_allocator(), std::in_place_index<0>, body};
+      };
+
+      const outcome parsed{std::allocator_arg, alloc, std::in_place_index<0>, long_text};
+      const outcome rejected{std::allocator_arg, alloc, std::in_place_index<1>, long_text};
+      const either<text, text> left{std::allocator_arg, alloc, std::in_place_index<0>, long_text};
+      const maybe<text> some{std::allocator_arg, alloc, std::in_place, long_text};
+
+      const auto accepted = parsed.map(annotate).and_then(validate);
+      const auto forwarded = rejected.map(annotate).and_then(validate);
+      const auto unchanged = parsed.map_error(annotate);
+      const auto kept = left.right_map(annotate);
+      const auto recovered = some.or_else([] {});
+      const auto extracted = rejected.error().value_or(text{});
+
+      CHECK(guard.counter.allocations == 0);
+      CHECK(accepted.value_ptr()->ends_with("buffer annotated"));
+      CHECK(forwarded.error_ptr()->get_allocator().resource() == &arena.resource);
+      CHECK(unchanged.value_ptr()->get_allocator().resource() == &arena.resource);
+      CHECK(kept.left_ptr()->get_allocator().resource() == &arena.resource);
+      CHECK(recovered->get_allocator().resource() == &arena.resource);
+      CHECK(extracted.get_allocator().resource() == &arena.resource);
+
+      const outcome copied = rejected;
+      CHECK(guard.counter.allocations == 1);
+      CHECK(copied.error_ptr()->get_allocator().resource() == &guard.counter);
+   }
+}
+
+enum class lookup_code : std::uint16_t
+{
+   missing_key,
+   out_of_range,
+   unnamed
+};
+
+template <>
+struct monad::error_category<lookup_code>
+{
+   static constexpr std::uint16_t id = 1;
+   static constexpr std::string_view name = "lookup";
+   static constexpr std::array<std::string_view, 2> messages{"missing key {}",
+                                                             "index {} out of range, limit {}"};
+};
+
+/**
+ * Rendered during static initialization, whose order does not depend on the registration of the
+ * category
+ */
+const std::string early_message = error{lookup_code::missing_key, "early"}.message();
+
+TEST_CASE("interned error test suite")
+{
+   static_assert(std::is_trivially_copyable_v<error>);
+   static_assert(sizeof(error) == 3 * sizeof(std::uint64_t));
+   static_assert(sizeof(maybe<error>) == sizeof(error));
+   static_assert(sizeof(result<void, error>) == sizeof(error));
+
+   SUBCASE("id")
+   {
+      constexpr error e{lookup_code::out_of_range, 12, 10U};
+
+      static_assert(e.category() == 1);
+      static_assert(e.code() == 1);
+      static_assert(e.id() == 0x0001'0001U);
+      static_assert(e == lookup_code::out_of_range);
+      static_assert(e == error{lookup_code::out_of_range});
+      static_assert(e != lookup_code::missing_key);
+
+      CHECK(e.category_name() == "lookup");
+      CHECK(error{std::errc::timed_out}.category_name() == "generic");
+   }
+
+   SUBCASE("lazy message")
+   {
+      CHECK(error{lookup_code::missing_key, "user"}.message() == "missing key user");
+      CHECK(early_message == "missing key early");
+      CHECK(error{lookup_code::out_of_range, -3, 2.5}.message() ==
+            "index -3 out of range, limit 2.5");
+      CHECK(error{lookup_code::out_of_range, 'x'}.message() == "index x out of range, limit {}");
+      CHECK(error{lookup_code::missing_key, true, 1}.message() == "missing key true");
+      CHECK(error{lookup_code::unnamed}.message() == "lookup error 2");
+      CHECK(error{std::errc::invalid_argument}.message() ==
+            std::make_error_code(std::errc::invalid_argument).message());
+   }
+
+   SUBCASE("result")
+   {
+      const auto find = [](int key) -> result<int, error> {
+         if (key < 0)
+         {
+            return make_error(error{lookup_code::missing_key, key});
+         }
+
+         return make_value(key * 2);
+      };
+      const auto bounded = [](int value) -> result<int, error> {
+         if (value > 10)
+         {
+            return make_error(error{lookup_code::out_of_range, value, 10});
+         }
+
+         return make_value(value);
+      };
+
+      CHECK(*find(4).and_then(bounded).value_ptr() == 8);
+      CHECK(*find(-1).and_then(bounded).error_ptr() == lookup_code::missing_key);
+      CHECK(find(6).and_then(bounded).error_ptr()->message() == "index 12 out of range, limit 10");
+   }
+
+   SUBCASE("try_wrap")
+   {
+      const auto thrown =
+         try_wrap<error>([]() -> int { throw error{lookup_code::missing_key, 7}; });
+      CHECK(*thrown.error_ptr() == lookup_code::missing_key);
+      CHECK(thrown.error_ptr()->message() == "missing key 7");
+
+      const auto system = try_wrap<error>([]() -> int {
+         throw std::system_error{std::make_error_code(std::errc::permission_denied)};
+      });
+      CHECK(*system.error_ptr() == std::errc::permission_denied);
+
+      CHECK(*try_wrap<error>([] { return 3; }).value_ptr() == 3);
+   }
+}
+
+TEST_CASE("error context test suite")
+{
+   const auto read_header = [](int size) -> result<int, std::errc> {
+      if (size < 0)
+      {
+         return make_error(std::errc::invalid_argument);
+      }
+
+      return make_value(size);
+   };
+
+   static_assert(std::is_trivially_copyable_v<contextual<std::errc>>);
+   static_assert(std::is_same_v<decltype(read_header(0).context("")),
+                                result<int, contextual<std::errc>>>);
+   static_assert(std::is_same_v<decltype(read_header(0).context("").context("")),
+                                result<int, contextual<std::errc>>>);
+
+   SUBCASE("frames from the innermost layer outwards")
+   {
+      const auto line = std::source_location::current().line();
+      const auto failed = read_header(-1)
+                             .context("while parsing header")
+                             .map([](int size) { return size * 2; })
+                             .context("while reading request");
+
+      REQUIRE(!failed.is_value());
+      const auto& error = *failed.error_ptr();
+      CHECK(error.error() == std::errc::invalid_argument);
+      CHECK(error.omitted() == 0);
+      REQUIRE(error.frames().size() == 2);
+      CHECK(std::string_view{error.frames()[0].what} == "while parsing header");
+      CHECK(std::string_view{error.frames()[1].what} == "while reading request");
+      CHECK(error.frames()[0].where.line() > line);
+      CHECK(std::string_view{error.frames()[0].where.file_name()}.ends_with("main.cpp"));
+   }
+
+   SUBCASE("values pass through")
+   {
+      const auto read = read_header(4).context("while parsing header");
+
+      CHECK(*read.value_ptr() == 4);
+      CHECK(*read.context("while reading request").value_ptr() == 4);
+   }
+
+   SUBCASE("frames past the capacity are counted")
+   {
+      auto failed = read_header(-1).context("1");
+      for (int i = 0; i < 5; ++i)
+      {
+         failed = std::move(failed).context("more");
+      }
+
+      CHECK(failed.error_ptr()->frames().size() == contextual<std::errc>::capacity);
+      CHECK(failed.error_ptr()->omitted() == 2);
+      CHECK(std::string_view{failed.error_ptr()->frames()[0].what} == "1");
+   }
+
+   SUBCASE("result<void, E>")
+   {
+      const result<void, std::string> failed = make_error(std::string{"disk full"});
+      const result<void, std::string> succeeded = make_value();
+
+      const auto with_context = failed.context("while flushing");
+      CHECK(with_context.error_ptr()->error() == "disk full");
+      CHECK(with_context.error_ptr()->frames().size() == 1);
+      CHECK(succeeded.context("while flushing").is_value());
+   }
+}